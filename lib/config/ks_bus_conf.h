@@ -7,3 +7,6 @@
 
 #define KS_BUS_HEALTH_PING  "B_HEALTH_PING"
 #define KS_BUS_HEALTH_PONG  "B_HEALTH_PONG"
+
+#define KS_BUS_LOGGER       "B_LOGGER"
+#define KS_BUS_TLM_LOGGER   "B_TLM_LOGGER"
@@ -1,3 +1,181 @@
 #pragma once
 
 #define KS_TRACE
+
+// Number of event messages that can be in flight at the same time
+#ifndef KS_EVENT_MESSAGE_POOL_SIZE
+#define KS_EVENT_MESSAGE_POOL_SIZE 64
+#endif
+
+// Largest event payload stored inside the event message itself
+#ifndef KS_PAYLOAD_INLINE_SIZE
+#define KS_PAYLOAD_INLINE_SIZE 32
+#endif
+
+// Size and number of the pooled blocks used by larger event payloads
+#ifndef KS_PAYLOAD_BLOCK_SIZE
+#define KS_PAYLOAD_BLOCK_SIZE 1024
+#endif
+
+#ifndef KS_PAYLOAD_BLOCK_COUNT
+#define KS_PAYLOAD_BLOCK_COUNT 16
+#endif
+
+// Number of buffers a typed bus can loan out for zero-copy publishing, enough for a downlink to fill a lane of the
+// command transmitter before its publisher waits for buffers to come back
+#ifndef KS_BUS_LOAN_COUNT
+#define KS_BUS_LOAN_COUNT KS_QUEUE_TRANSMITTER_SIZE
+#endif
+
+// Ticks a publisher waits for a loaned buffer to be released when the loan pool of its bus is exhausted
+#ifndef KS_BUS_LOAN_WAIT_TIME
+#define KS_BUS_LOAN_WAIT_TIME 1000
+#endif
+
+// Length of the high priority lane of the component queues, the other lanes are sized by each component
+#ifndef KS_QUEUE_HIGH_PRIORITY_SIZE
+#define KS_QUEUE_HIGH_PRIORITY_SIZE 10
+#endif
+
+// Length of the low and normal priority lanes of the command transmitter, which absorbs the packets of a downlink
+#ifndef KS_QUEUE_TRANSMITTER_SIZE
+#define KS_QUEUE_TRANSMITTER_SIZE 96
+#endif
+
+// Calibration mode: every lane is created with KS_QUEUE_CALIBRATION_SIZE events and no queue profile is applied, so
+// that the high-water marks recorded under load aren't clipped by the current sizes. See Framework::SaveQueueProfile()
+#ifndef KS_QUEUE_CALIBRATION
+#define KS_QUEUE_CALIBRATION 0
+#endif
+
+#ifndef KS_QUEUE_CALIBRATION_SIZE
+#define KS_QUEUE_CALIBRATION_SIZE 128
+#endif
+
+// File the queue profile is saved to and applied from at boot, and the margin added to its peaks in percent
+#ifndef KS_QUEUE_PROFILE_FILE
+#define KS_QUEUE_PROFILE_FILE "/queues"
+#endif
+
+#ifndef KS_QUEUE_PROFILE_MARGIN
+#define KS_QUEUE_PROFILE_MARGIN 25
+#endif
+
+// Largest number of events published or processed in a single batch
+#ifndef KS_EVENT_BATCH_SIZE
+#define KS_EVENT_BATCH_SIZE 8
+#endif
+
+// Number of event codes a queued component can coalesce at the same time
+#ifndef KS_COALESCE_SLOTS
+#define KS_COALESCE_SLOTS 4
+#endif
+
+// Number of calls an AsyncCall table can have waiting for a response at the same time
+#ifndef KS_ASYNC_CALL_COUNT
+#define KS_ASYNC_CALL_COUNT 8
+#endif
+
+// Ticks an asynchronous call waits for its response unless the caller says otherwise
+#ifndef KS_ASYNC_CALL_DEFAULT_TIMEOUT
+#define KS_ASYNC_CALL_DEFAULT_TIMEOUT 1000
+#endif
+
+// Number of event codes, starting from 0, that subscriptions can filter. Higher codes reach every subscriber
+#ifndef KS_EVENT_FILTER_SIZE
+#define KS_EVENT_FILTER_SIZE 64
+#endif
+
+// Ticks between two rebalancing passes of a worker pool with several workers
+#ifndef KS_WORKER_BALANCE_PERIOD
+#define KS_WORKER_BALANCE_PERIOD 1000
+#endif
+
+// Smoothed queue latency, in ticks, above which a component is moved to a less loaded worker of its pool
+#ifndef KS_WORKER_MIGRATION_LATENCY
+#define KS_WORKER_MIGRATION_LATENCY 5
+#endif
+
+// Largest number of events a worker processes from one component before moving on to the next ready one
+#ifndef KS_QUEUE_EVENT_BUDGET
+#define KS_QUEUE_EVENT_BUDGET 16
+#endif
+
+// Ticks a worker spends on one component before moving on to the next ready one
+#ifndef KS_QUEUE_TIME_BUDGET
+#define KS_QUEUE_TIME_BUDGET 5
+#endif
+
+// Size and number of the pooled blocks coroutine frames are allocated from, see ComponentCoroutine
+#ifndef KS_COROUTINE_FRAME_SIZE
+#define KS_COROUTINE_FRAME_SIZE 256
+#endif
+
+#ifndef KS_COROUTINE_FRAME_COUNT
+#define KS_COROUTINE_FRAME_COUNT 16
+#endif
+
+// Creates every task, queue, semaphore and timer of the framework with the static FreeRTOS API instead of heap_4.
+// Requires configSUPPORT_STATIC_ALLOCATION in FreeRTOSConfig.h
+#ifndef KS_STATIC_ALLOCATION
+#define KS_STATIC_ALLOCATION 0
+#endif
+
+// Bytes reserved at compile time for the task stacks and queue storage created in static allocation mode
+#ifndef KS_STATIC_ARENA_SIZE
+#define KS_STATIC_ARENA_SIZE (96 * 1024)
+#endif
+
+// Tasks helping the framework initialize the components of a dependency level in parallel, 0 initializes them one
+// after another
+#ifndef KS_BOOT_TASKS
+#define KS_BOOT_TASKS 2
+#endif
+
+#ifndef KS_BOOT_TASK_STACK_SIZE
+#define KS_BOOT_TASK_STACK_SIZE KS_COMPONENT_STACK_SIZE_LARGE
+#endif
+
+// Number of steps recorded in the boot timeline and the file it is written to, see BootTimeline
+#ifndef KS_BOOT_TIMELINE_SIZE
+#define KS_BOOT_TIMELINE_SIZE 64
+#endif
+
+#ifndef KS_BOOT_TIMELINE_FILE
+#define KS_BOOT_TIMELINE_FILE "/boot"
+#endif
+
+// Schedules the scheduler holds at the same time, and distinct components they deliver to, see Scheduler
+#ifndef KS_SCHEDULER_CAPACITY
+#define KS_SCHEDULER_CAPACITY 64
+#endif
+
+#ifndef KS_SCHEDULER_SUBSCRIBERS
+#define KS_SCHEDULER_SUBSCRIBERS 16
+#endif
+
+// Levels of the timing wheel of the scheduler and slots per level as a power of two. The wheel spans
+// 2^(bits * levels) scheduler ticks, later deadlines wait on the last level until they come in range
+#ifndef KS_SCHEDULER_WHEEL_BITS
+#define KS_SCHEDULER_WHEEL_BITS 6
+#endif
+
+#ifndef KS_SCHEDULER_WHEEL_LEVELS
+#define KS_SCHEDULER_WHEEL_LEVELS 4
+#endif
+
+// Scheduler ticks over which the scheduler counts the periodic events due on every tick to pick the phase of new
+// schedules. Phases are exact for the periods that divide it, so a number with many divisors works best
+#ifndef KS_SCHEDULER_PHASE_WINDOW
+#define KS_SCHEDULER_PHASE_WINDOW 240
+#endif
+
+// Task delivering the scheduled events, woken by the scheduler timer on every tick. It runs below the timer task so
+// that delivering never delays the other software timers
+#ifndef KS_SCHEDULER_TASK_PRIORITY
+#define KS_SCHEDULER_TASK_PRIORITY KS_COMPONENT_PRIORITY_HIGH
+#endif
+
+#ifndef KS_SCHEDULER_TASK_STACK_SIZE
+#define KS_SCHEDULER_TASK_STACK_SIZE KS_COMPONENT_STACK_SIZE_MEDIUM
+#endif
@@ -18,6 +18,8 @@ namespace kronos {
         ks_error_bus_no_subscribers,
         ks_error_bus_publish,
         ks_error_bus_component_subscribed,
+        ks_error_bus_loan_exhausted,
+        ks_error_bus_subscribers_full,
 
         // Components
         ks_error_component_exists,
@@ -27,8 +29,12 @@ namespace kronos {
         ks_error_component_task_create,
         ks_error_component_task_delete,
         ks_error_component_receive_event,
+        ks_error_component_event_dropped,
         ks_error_component_process_event,
         ks_error_component_run,
+        ks_error_component_worker_full,
+        ks_error_component_worker_missing,
+        ks_error_component_queue_created,
 
         // Modules
         ks_error_module_add,
@@ -36,11 +42,30 @@ namespace kronos {
         ks_error_module_initialize,
         ks_error_module_cyclic_dependency,
 
+        // Topology
+        ks_error_topology_exists,
+        ks_error_topology_full,
+        ks_error_topology_name,
+
+        // Async calls
+        ks_error_async_call_full,
+        ks_error_async_call_missing,
+        ks_error_async_call_timeout,
+
+        // Static allocation
+        ks_error_static_arena_exhausted,
+
+        // Coroutines
+        ks_error_coroutine_frame_exhausted,
+        ks_error_coroutine_timer,
+
         // Drivers
         ks_error_driver_missing,
 
         // Event Message
         ks_error_event_message_missing,
+        ks_error_event_message_pool_exhausted,
+        ks_error_payload_pool_exhausted,
 
         // Apollo Format errors,
         ks_error_apolloformat_status_uninitianalized,
@@ -71,6 +96,8 @@ namespace kronos {
         // Scheduler related errors
         ks_error_scheduler_rate_exists,
         ks_error_scheduler_rate_missing,
+        ks_error_scheduler_full,
+        ks_error_scheduler_missing,
 
         // Comms related errors
         ks_error_invalid_packet_header,
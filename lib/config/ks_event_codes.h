@@ -2,6 +2,8 @@
 
 namespace kronos {
     typedef uint16_t KsEventCodeType;
+    //! Matches a response to the request it answers, 0 when the event is not part of a call
+    typedef uint32_t KsCorrelationIdType;
 
     enum KsEventCode : KsEventCodeType {
         // Tick event for scheduled components
@@ -45,4 +47,18 @@ namespace kronos {
         // Invalid Event
         ks_event_invalid = UINT16_MAX
     };
+
+    // Number of priority lanes in the queue of every queued component
+    #define KS_EVENT_PRIORITY_LANES 3
+
+    enum KsEventPriority : uint8_t {
+        // Bulk traffic that can wait, such as file parts and telemetry
+        ks_event_priority_low,
+        ks_event_priority_normal,
+        // Latency sensitive events, such as health pings and command acknowledgements
+        ks_event_priority_high,
+
+        // Use the default priority of the bus the event is published on
+        ks_event_priority_bus = UINT8_MAX
+    };
 }
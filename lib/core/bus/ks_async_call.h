@@ -0,0 +1,204 @@
+#pragma once
+
+#include "ks_bus.h"
+
+namespace kronos {
+
+    //! \class AsyncCall
+    //! \brief Table of the requests a component is waiting on, matched to their responses by correlation id.
+    //!
+    //! A call publishes a request tagged with a fresh correlation id and the reply bus of the table. The
+    //! responder answers with Bus::Reply(), which publishes on that reply bus with the same id. The caller then
+    //! hands every event received from its reply bus to Complete(), which runs the callback of the matching call.
+    //! Calls that are not answered in time are completed with ks_error_async_call_timeout by Expire(). Since
+    //! nothing blocks while waiting, a component can keep many calls in flight.
+    //!
+    //! The table belongs to a single component and must only be used from the task processing its events.
+    //!
+    //! \tparam Capacity The number of calls that can wait for a response at the same time.
+    template<size_t Capacity = KS_ASYNC_CALL_COUNT>
+    class AsyncCall {
+    public:
+        //! \brief Function called once per call, with the response or with the error that ended the call.
+        //!
+        //! \param context The context given to Call().
+        //! \param response The response, nullptr if the call failed.
+        //! \param result ks_success, ks_error_async_call_timeout or the error given to Cancel().
+        using Callback = void (*)(void* context, const EventMessage* response, KsResult result);
+
+        //! \brief Constructor to create an empty call table.
+        //!
+        //! \param replyBus The bus the responses are published on, the owner of the table must subscribe to it.
+        explicit AsyncCall(Bus* replyBus) : m_ReplyBus(replyBus) {}
+
+        AsyncCall(const AsyncCall& other) = delete;
+        void operator=(const AsyncCall& other) = delete;
+
+        //! \brief Publishes a request carrying data and waits for its response without blocking.
+        //!
+        //! \param bus The bus the request is published on.
+        //! \param data The data carried by the request.
+        //! \param eventCode The event code of the request.
+        //! \param callback Called when the response arrives or the call fails.
+        //! \param context Passed back to the callback.
+        //! \param timeout Ticks to wait for the response.
+        //! \param correlationId Set to the id of the call, used to cancel it. Can be nullptr.
+        //! \return ks_error_async_call_full if too many calls are waiting, or the error of the publish.
+        template<typename T>
+        KsResult Call(
+            Bus* bus,
+            T&& data,
+            KsEventCodeType eventCode,
+            Callback callback,
+            void* context = nullptr,
+            KsTickType timeout = KS_ASYNC_CALL_DEFAULT_TIMEOUT,
+            KsCorrelationIdType* correlationId = nullptr
+        ) {
+            return Send(callback, context, timeout, correlationId, [&](KsCorrelationIdType id) {
+                return bus->Request(std::forward<T>(data), eventCode, m_ReplyBus, id);
+            });
+        }
+
+        //! \brief Publishes a request without data. See Call().
+        KsResult Call(
+            Bus* bus,
+            KsEventCodeType eventCode,
+            Callback callback,
+            void* context = nullptr,
+            KsTickType timeout = KS_ASYNC_CALL_DEFAULT_TIMEOUT,
+            KsCorrelationIdType* correlationId = nullptr
+        ) {
+            return Send(callback, context, timeout, correlationId, [&](KsCorrelationIdType id) {
+                return bus->Request(eventCode, m_ReplyBus, id);
+            });
+        }
+
+        //! \brief Completes the call a response belongs to.
+        //!
+        //! \param response An event received from the reply bus.
+        //! \return true if the response matched a waiting call, false if it is late or not a response.
+        bool Complete(const EventMessage& response) {
+            PendingCall* call = Find(response.correlationId);
+            if (call == nullptr) return false;
+
+            Finish(call, &response, ks_success);
+            return true;
+        }
+
+        //! \brief Fails every call whose response did not arrive in time.
+        //!
+        //! \return The number of calls that timed out.
+        size_t Expire() {
+            KsTickType now = xTaskGetTickCount();
+
+            size_t expired = 0;
+            for (auto& call: m_Calls) {
+                // Compared as a difference so that the tick count can wrap around
+                if (call.id != 0 && static_cast<int32_t>(now - call.deadline) >= 0) {
+                    Finish(&call, nullptr, ks_error_async_call_timeout);
+                    expired++;
+                }
+            }
+
+            return expired;
+        }
+
+        //! \brief Stops waiting for a call, its callback runs right away with the given result.
+        //!
+        //! \return ks_error_async_call_missing if the call already completed.
+        KsResult Cancel(KsCorrelationIdType correlationId, KsResult result = ks_error_async_call_missing) {
+            PendingCall* call = Find(correlationId);
+            if (call == nullptr) KS_THROW(ks_error_async_call_missing);
+
+            Finish(call, nullptr, result);
+            return ks_success;
+        }
+
+        //! \brief Getter for the number of calls waiting for a response.
+        [[nodiscard]] size_t GetPending() const {
+            return std::count_if(std::begin(m_Calls), std::end(m_Calls), [](const auto& call) { return call.id != 0; });
+        }
+
+        //! \brief Getter for the bus the responses are published on.
+        [[nodiscard]] Bus* GetReplyBus() const {
+            return m_ReplyBus;
+        }
+
+    private:
+        //! A call waiting for its response
+        struct PendingCall {
+            //! Correlation id of the call, 0 if the slot is free
+            KsCorrelationIdType id = 0;
+            //! Tick at which the call times out
+            KsTickType deadline = 0;
+            Callback callback = nullptr;
+            void* context = nullptr;
+        };
+
+        template<typename F>
+        KsResult Send(
+            Callback callback,
+            void* context,
+            KsTickType timeout,
+            KsCorrelationIdType* correlationId,
+            F&& publish
+        ) {
+            PendingCall* call = FindFree();
+            if (call == nullptr) KS_THROW(ks_error_async_call_full);
+
+            // The slot is claimed before publishing in case the response comes back synchronously
+            *call = {
+                .id = NextId(),
+                .deadline = xTaskGetTickCount() + timeout,
+                .callback = callback,
+                .context = context
+            };
+
+            KsCorrelationIdType id = call->id;
+            KsResult result = publish(id);
+            if (result != ks_success) {
+                if (call->id == id) *call = {};
+                return result;
+            }
+
+            if (correlationId != nullptr) *correlationId = id;
+            return ks_success;
+        }
+
+        void Finish(PendingCall* call, const EventMessage* response, KsResult result) {
+            // The slot is freed first so that the callback can make a new call
+            PendingCall finished = std::exchange(*call, {});
+            if (finished.callback != nullptr) finished.callback(finished.context, response, result);
+        }
+
+        PendingCall* Find(KsCorrelationIdType correlationId) {
+            if (correlationId == 0) return nullptr;
+
+            for (auto& call: m_Calls) {
+                if (call.id == correlationId) return &call;
+            }
+
+            return nullptr;
+        }
+
+        PendingCall* FindFree() {
+            for (auto& call: m_Calls) {
+                if (call.id == 0) return &call;
+            }
+
+            return nullptr;
+        }
+
+        KsCorrelationIdType NextId() {
+            // 0 marks events that aren't part of a call
+            if (++m_NextId == 0) ++m_NextId;
+            return m_NextId;
+        }
+
+    private:
+        Bus* m_ReplyBus;
+        PendingCall m_Calls[Capacity]{};
+        KsCorrelationIdType m_NextId = 0;
+    };
+
+}
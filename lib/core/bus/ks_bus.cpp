@@ -2,18 +2,179 @@
 
 
 namespace kronos {
-    Bus::Bus(String name)
-        : m_Name(std::move(name)) {}
+    Bus::Bus(String name, KsEventPriority priority)
+        : m_Name(std::move(name)), m_Priority(priority) {}
 
     const String& Bus::GetName() const {
         return m_Name;
     }
 
+    KsEventPriority Bus::GetPriority() const {
+        return m_Priority;
+    }
+
+    void Bus::SetPriority(KsEventPriority priority) {
+        m_Priority = priority;
+    }
+
+    void Bus::SetOverflowPolicy(KsOverflowPolicy overflow, KsTickType timeout) {
+        m_Overflow = overflow;
+        m_OverflowTimeout = timeout;
+    }
+
     KsResult Bus::AddReceivingComponent(ComponentBase* component) {
-        KS_LIST_FIND(m_ReceivingComponents, component, it) {
-            KS_THROW(ks_error_bus_component_subscribed);
+        return AddReceivingComponent(component, m_Overflow, m_OverflowTimeout);
+    }
+
+    KsResult Bus::AddReceivingComponent(ComponentBase* component, KsOverflowPolicy overflow, KsTickType timeout) {
+        return AddReceivingComponent(component, EventFilter{}, overflow, timeout);
+    }
+
+    KsResult Bus::AddReceivingComponent(ComponentBase* component, const EventFilter& events) {
+        return AddReceivingComponent(component, events, m_Overflow, m_OverflowTimeout);
+    }
+
+    KsResult Bus::AddReceivingComponent(
+        ComponentBase* component,
+        const EventFilter& events,
+        KsOverflowPolicy overflow,
+        KsTickType timeout
+    ) {
+        Framework::RegistryLock lock;
+        if (GetDeliveryStats(component) != nullptr) KS_THROW(ks_error_bus_component_subscribed);
+        if (m_Subscriptions.size() >= s_MaxSubscriptions) KS_THROW(ks_error_bus_subscribers_full);
+
+        // A bound static table can't grow, the bus falls back to owning a copy of it
+        if (m_Subscriptions.data() != m_OwnedSubscriptions.data())
+            m_OwnedSubscriptions = List<Subscription>(m_Subscriptions.begin(), m_Subscriptions.end());
+
+        m_OwnedSubscriptions.push_back({
+            .component = component,
+            .events = events,
+            .overflow = overflow,
+            .timeout = timeout
+        });
+        m_Subscriptions = m_OwnedSubscriptions;
+
+        BuildRoutes();
+        return ks_success;
+    }
+
+    KsResult Bus::AddReceivingEvents(const ComponentBase* component, const EventFilter& events) {
+        Framework::RegistryLock lock;
+        for (auto& subscription: m_Subscriptions) {
+            if (subscription.component != component) continue;
+
+            subscription.events.Add(events);
+            BuildRoutes();
+            return ks_success;
+        }
+
+        KS_THROW(ks_error_bus_missing);
+    }
+
+    KsResult Bus::BindSubscriptions(std::span<Subscription> subscriptions) {
+        if (!m_Subscriptions.empty()) KS_THROW(ks_error_bus_component_subscribed);
+        if (subscriptions.size() > s_MaxSubscriptions) KS_THROW(ks_error_bus_subscribers_full);
+
+        m_Subscriptions = subscriptions;
+
+        BuildRoutes();
+        return ks_success;
+    }
+
+    void Bus::BuildRoutes() {
+        m_AllRoutes = 0;
+        std::fill(std::begin(m_Routes), std::end(m_Routes), 0);
+
+        for (size_t i = 0; i < m_Subscriptions.size(); i++) {
+            uint32_t bit = 1u << i;
+            m_AllRoutes |= bit;
+
+            for (KsEventCodeType eventCode = 0; eventCode < KS_EVENT_FILTER_SIZE; eventCode++) {
+                if (m_Subscriptions[i].events.Matches(eventCode)) m_Routes[eventCode] |= bit;
+            }
+        }
+    }
+
+    const DeliveryStats* Bus::GetDeliveryStats(const ComponentBase* component) const {
+        for (const auto& subscription: m_Subscriptions) {
+            if (subscription.component == component) return &subscription.stats;
         }
 
-        m_ReceivingComponents.push_back(component);
+        return nullptr;
+    }
+
+    KsResult Bus::Dispatch(EventMessage* message, KsEventPriority priority) {
+        uint32_t route = GetRoute(message->eventCode);
+        if (route == 0) return Framework::ReleaseEventMessage(message);
+
+        message->priority = priority == ks_event_priority_bus ? m_Priority : priority;
+
+        // Every subscriber owns a reference before the first one gets a chance to release it
+        message->references.store(std::popcount(route), std::memory_order_release);
+
+        bool delivered = true;
+        ForEachRoute(route, [&](const Subscription& subscription) {
+            if (!Delivered(subscription.component->ReceiveEvent(message, subscription)))
+                delivered = false;
+        });
+
+        if (!delivered) KS_THROW(ks_error_bus_publish);
+
+        return ks_success;
+    }
+
+    KsResult Bus::DispatchFromISR(EventMessage* message, KsEventPriority priority, BaseType_t* higherPriorityTaskWoken) {
+        uint32_t route = GetRoute(message->eventCode);
+        message->priority = priority == ks_event_priority_bus ? m_Priority : priority;
+        message->references.store(std::popcount(route), std::memory_order_release);
+
+        // Errors can't be traced from an interrupt, they are only returned
+        bool delivered = true;
+        ForEachRoute(route, [&](const Subscription& subscription) {
+            if (!Delivered(subscription.component->ReceiveEventFromISR(message, subscription, higherPriorityTaskWoken)))
+                delivered = false;
+        });
+
+        return delivered ? ks_success : ks_error_bus_publish;
+    }
+
+    bool Bus::Delivered(KsResult result) {
+        // Events dropped by the overflow policy of a subscription are accounted for in its counters
+        return result == ks_success || result == ks_error_component_event_dropped;
+    }
+
+    KsResult Bus::DispatchBatch(std::span<EventMessage*> messages, KsEventPriority priority) {
+        KS_ASSERT(messages.size() <= KS_EVENT_BATCH_SIZE, "Batch is larger than KS_EVENT_BATCH_SIZE")
+
+        uint32_t routes[KS_EVENT_BATCH_SIZE];
+        uint32_t route = 0;
+        for (size_t i = 0; i < messages.size(); i++) {
+            routes[i] = GetRoute(messages[i]->eventCode);
+            route |= routes[i];
+
+            messages[i]->priority = priority == ks_event_priority_bus ? m_Priority : priority;
+            messages[i]->references.store(std::popcount(routes[i]), std::memory_order_release);
+        }
+
+        bool delivered = true;
+        ForEachRoute(route, [&](const Subscription& subscription) {
+            uint32_t bit = 1u << (&subscription - m_Subscriptions.data());
+
+            // Each subscriber only receives the part of the batch its filter accepts
+            const EventMessage* accepted[KS_EVENT_BATCH_SIZE];
+            size_t acceptedCount = 0;
+            for (size_t i = 0; i < messages.size(); i++) {
+                if (routes[i] & bit) accepted[acceptedCount++] = messages[i];
+            }
+
+            if (!Delivered(subscription.component->ReceiveEvents({ accepted, acceptedCount }, subscription)))
+                delivered = false;
+        });
+
+        if (!delivered) KS_THROW(ks_error_bus_publish);
+
+        return ks_success;
     }
 }
\ No newline at end of file
@@ -15,63 +15,270 @@ namespace kronos {
         //! \brief Constructor to create a new bus
         //!
         //! \param name the name of the bus
-        explicit Bus(String name);
+        //! \param priority the priority of the events published on the bus, unless overridden by the publisher
+        explicit Bus(String name, KsEventPriority priority = ks_event_priority_normal);
 
         //! \brief Virtual destructor to be invoked for proper destruction of child classes.
-        ~Bus() = default;
+        virtual ~Bus() = default;
 
-        //! \brief Adds a new subscriber to the bus
+        //! \brief Adds a new subscriber to the bus, using the default overflow policy of the bus
         //!
         //! \param component pointer to the component that is subscribing to the bus
         KsResult AddReceivingComponent(ComponentBase* component);
 
-        //! \brief
+        //! \brief Adds a new subscriber to the bus
+        //!
+        //! \param component pointer to the component that is subscribing to the bus
+        //! \param overflow what happens to the events published while the queue of the component is full
+        //! \param timeout ticks the publisher waits for room in the queue, only used by ks_overflow_block
+        KsResult AddReceivingComponent(ComponentBase* component, KsOverflowPolicy overflow, KsTickType timeout = 0);
+
+        //! \brief Adds a new subscriber that only receives some event codes, using the default overflow policy
+        //!
+        //! \param component pointer to the component that is subscribing to the bus
+        //! \param events the event codes delivered to the component, the others are never queued for it
+        KsResult AddReceivingComponent(ComponentBase* component, const EventFilter& events);
+
+        //! \brief Adds a new subscriber that only receives some event codes
+        //!
+        //! \param component pointer to the component that is subscribing to the bus
+        //! \param events the event codes delivered to the component, the others are never queued for it
+        //! \param overflow what happens to the events published while the queue of the component is full
+        //! \param timeout ticks the publisher waits for room in the queue, only used by ks_overflow_block
+        KsResult AddReceivingComponent(
+            ComponentBase* component,
+            const EventFilter& events,
+            KsOverflowPolicy overflow,
+            KsTickType timeout = 0
+        );
+
+        //! \brief Delivers more event codes to an existing subscriber
         //!
-        //! \tparam T
-        //! \param data
-        //! \param returnBus
+        //! \param component pointer to a component subscribed to the bus
+        //! \param events the event codes to deliver to the component on top of the ones it already receives
+        //! \return ks_error_bus_missing if the component isn't subscribed to the bus
+        KsResult AddReceivingEvents(const ComponentBase* component, const EventFilter& events);
+
+        //! \brief Makes the bus deliver to a statically allocated subscription table, see Topology.
+        //!
+        //! Subscribers added later through AddReceivingComponent() are appended to a copy of the table.
+        //!
+        //! \param subscriptions The subscriptions, they must outlive the bus.
+        //! \return ks_error_bus_component_subscribed if the bus already has subscribers.
+        KsResult BindSubscriptions(std::span<Subscription> subscriptions);
+
+        //! \brief Sets the overflow policy used by the subscriptions made without one
+        //!
+        //! \param overflow what happens to the events published while the queue of a subscriber is full
+        //! \param timeout ticks the publisher waits for room in the queue, only used by ks_overflow_block
+        void SetOverflowPolicy(KsOverflowPolicy overflow, KsTickType timeout = 0);
+
+        //! \brief Getter for the delivery counters of a subscriber
+        //!
+        //! \return The counters, nullptr if the component isn't subscribed to the bus
+        [[nodiscard]] const DeliveryStats* GetDeliveryStats(const ComponentBase* component) const;
+
+        //! \brief Publishes an event carrying data to every subscriber of the bus.
+        //!
+        //! A single message is created for the whole publish and shared by every subscriber, so the data is only
+        //! copied (or moved) once regardless of the number of subscribers.
+        //!
+        //! \tparam T The type of the data.
+        //! \param data The data carried by the event.
+        //! \param eventCode The event code.
+        //! \param returnBus The bus on which a response should be published, if any.
+        //! \param priority The priority of the event, defaults to the priority of the bus.
         template<typename T>
-        KsResult Publish(const T& data, KsEventCodeType eventCode, Bus* returnBus = nullptr) {
-            if (m_ReceivingComponents.empty())
-                KS_THROW(ks_error_bus_no_subscribers);
+        KsResult Publish(
+            T&& data,
+            KsEventCodeType eventCode,
+            Bus* returnBus = nullptr,
+            KsEventPriority priority = ks_event_priority_bus
+        ) {
+            if (m_Subscriptions.empty()) KS_THROW(ks_error_bus_no_subscribers);
+            if (GetRoute(eventCode) == 0) return ks_success;
 
-            for (auto component: m_ReceivingComponents) {
-                EventMessage* message = Framework::CreateEventMessage<T>(data, eventCode, returnBus);
-                KS_TRY(ks_error_bus_publish, component->ReceiveEvent(message));
-            }
+            EventMessage* message = Framework::CreateEventMessage<T>(std::forward<T>(data), eventCode, returnBus);
+            if (message == nullptr) KS_THROW(ks_error_event_message_pool_exhausted);
 
-            return ks_success;
+            return Dispatch(message, priority);
         }
 
-        //! \brief
+        //! \brief Publishes an event without data to every subscriber of the bus.
         //!
-        //! \tparam T
-        //! \param data
-        //! \param returnBus
+        //! \param eventCode The event code.
+        //! \param returnBus The bus on which a response should be published, if any.
+        //! \param priority The priority of the event, defaults to the priority of the bus.
+        KsResult Publish(
+            KsEventCodeType eventCode,
+            Bus* returnBus = nullptr,
+            KsEventPriority priority = ks_event_priority_bus
+        ) {
+            if (m_Subscriptions.empty()) KS_THROW(ks_error_bus_no_subscribers);
+            if (GetRoute(eventCode) == 0) return ks_success;
+
+            EventMessage* message = Framework::CreateEventMessage(eventCode, returnBus);
+            if (message == nullptr) KS_THROW(ks_error_event_message_pool_exhausted);
+
+            return Dispatch(message, priority);
+        }
+
+        //! \brief Publishes a request carrying data, tagged so that its response can be matched to it.
+        //!
+        //! Callers usually go through AsyncCall, which picks the correlation id and tracks the response.
+        //!
+        //! \param data The data carried by the request.
+        //! \param eventCode The event code.
+        //! \param returnBus The bus on which the response should be published.
+        //! \param correlationId The id the response will carry back.
+        //! \param priority The priority of the event, defaults to the priority of the bus.
         template<typename T>
-        KsResult Publish(T&& data, KsEventCodeType eventCode, Bus* returnBus = nullptr) {
-            if (m_ReceivingComponents.empty()) KS_THROW(ks_error_bus_no_subscribers);
+        KsResult Request(
+            T&& data,
+            KsEventCodeType eventCode,
+            Bus* returnBus,
+            KsCorrelationIdType correlationId,
+            KsEventPriority priority = ks_event_priority_bus
+        ) {
+            if (m_Subscriptions.empty()) KS_THROW(ks_error_bus_no_subscribers);
+            if (GetRoute(eventCode) == 0) return ks_success;
 
-            for (auto component: m_ReceivingComponents) {
-                EventMessage* message = Framework::CreateEventMessage<T>(std::forward<T>(data), eventCode, returnBus);
-                component->ReceiveEvent(message);
-            }
+            EventMessage* message = Framework::CreateEventMessage<T>(std::forward<T>(data), eventCode, returnBus);
+            if (message == nullptr) KS_THROW(ks_error_event_message_pool_exhausted);
 
-            return ks_success;
+            message->correlationId = correlationId;
+            return Dispatch(message, priority);
+        }
+
+        //! \brief Publishes a request without data. See Request().
+        KsResult Request(
+            KsEventCodeType eventCode,
+            Bus* returnBus,
+            KsCorrelationIdType correlationId,
+            KsEventPriority priority = ks_event_priority_bus
+        ) {
+            if (m_Subscriptions.empty()) KS_THROW(ks_error_bus_no_subscribers);
+            if (GetRoute(eventCode) == 0) return ks_success;
+
+            EventMessage* message = Framework::CreateEventMessage(eventCode, returnBus);
+            if (message == nullptr) KS_THROW(ks_error_event_message_pool_exhausted);
+
+            message->correlationId = correlationId;
+            return Dispatch(message, priority);
         }
 
-        //! \brief
+        //! \brief Publishes the response to a request on the return bus of the request.
         //!
-        //! \param returnBus
-        KsResult Publish(KsEventCodeType eventCode, Bus* returnBus = nullptr) {
-            if (m_ReceivingComponents.empty()) KS_THROW(ks_error_bus_no_subscribers);
+        //! \param request The request being answered, the response carries its correlation id.
+        //! \param data The data carried by the response.
+        //! \param eventCode The event code of the response.
+        //! \param priority The priority of the response, defaults to the priority of the return bus.
+        //! \return ks_error_bus_missing if the request has no return bus.
+        template<typename T>
+        static KsResult Reply(
+            const EventMessage& request,
+            T&& data,
+            KsEventCodeType eventCode,
+            KsEventPriority priority = ks_event_priority_bus
+        ) {
+            if (request.returnBus == nullptr) KS_THROW(ks_error_bus_missing);
 
-            for (auto component: m_ReceivingComponents) {
-                EventMessage* message = Framework::CreateEventMessage(eventCode, returnBus);
-                component->ReceiveEvent(message);
-            }
+            return request.returnBus->Request(std::forward<T>(data), eventCode, nullptr, request.correlationId, priority);
+        }
 
-            return ks_success;
+        //! \brief Publishes a response without data. See Reply().
+        static KsResult Reply(
+            const EventMessage& request,
+            KsEventCodeType eventCode,
+            KsEventPriority priority = ks_event_priority_bus
+        ) {
+            if (request.returnBus == nullptr) KS_THROW(ks_error_bus_missing);
+
+            return request.returnBus->Request(eventCode, nullptr, request.correlationId, priority);
+        }
+
+        //! \brief Publishes an event carrying data from an interrupt.
+        //!
+        //! The message comes from the preallocated event message pool and is queued with the FromISR API, so this
+        //! never blocks, never allocates and never touches the framework maps. Errors are returned but not traced.
+        //! Every subscriber must be a queued component and must be subscribed before the interrupt is enabled.
+        //! Yield with portYIELD_FROM_ISR(higherPriorityTaskWoken) at the end of the interrupt.
+        //!
+        //! \tparam T The type of the data, it must be trivially copyable and fit inline in a payload.
+        //! \param data The data carried by the event.
+        //! \param eventCode The event code.
+        //! \param higherPriorityTaskWoken Set to pdTRUE if a task should be switched to when the interrupt exits.
+        //! \param priority The priority of the event, defaults to the priority of the bus.
+        template<typename T>
+        KsResult PublishFromISR(
+            T&& data,
+            KsEventCodeType eventCode,
+            BaseType_t* higherPriorityTaskWoken,
+            KsEventPriority priority = ks_event_priority_bus
+        ) {
+            using Data = std::decay_t<T>;
+            static_assert(std::is_trivially_copyable_v<Data>, "Data published from an interrupt must be trivially copyable!");
+            static_assert(Payload::FitsInline<Data>(), "Data published from an interrupt must fit inline in a payload!");
+
+            if (m_Subscriptions.empty()) return ks_error_bus_no_subscribers;
+            if (GetRoute(eventCode) == 0) return ks_success;
+
+            EventMessage* message = Framework::CreateEventMessage(std::forward<T>(data), eventCode);
+            if (message == nullptr) return ks_error_event_message_pool_exhausted;
+
+            return DispatchFromISR(message, priority, higherPriorityTaskWoken);
+        }
+
+        //! \brief Publishes an event without data from an interrupt. See the other overload.
+        KsResult PublishFromISR(
+            KsEventCodeType eventCode,
+            BaseType_t* higherPriorityTaskWoken,
+            KsEventPriority priority = ks_event_priority_bus
+        ) {
+            if (m_Subscriptions.empty()) return ks_error_bus_no_subscribers;
+            if (GetRoute(eventCode) == 0) return ks_success;
+
+            EventMessage* message = Framework::CreateEventMessage(eventCode);
+            if (message == nullptr) return ks_error_event_message_pool_exhausted;
+
+            return DispatchFromISR(message, priority, higherPriorityTaskWoken);
+        }
+
+        //! \brief Publishes one event carrying data for every element of data, as a batch.
+        //!
+        //! Subscribers receive the events KS_EVENT_BATCH_SIZE at a time with a single ReceiveEvents() call, so a
+        //! queued subscriber is woken once per batch rather than once per event.
+        //!
+        //! \tparam T The type of the data.
+        //! \param data The data carried by each event.
+        //! \param eventCode The event code shared by every event.
+        //! \param returnBus The bus on which a response should be published, if any.
+        //! \param priority The priority of the events, defaults to the priority of the bus.
+        template<typename T>
+        KsResult PublishBatch(
+            std::span<const T> data,
+            KsEventCodeType eventCode,
+            Bus* returnBus = nullptr,
+            KsEventPriority priority = ks_event_priority_bus
+        ) {
+            return DispatchEach(data.size(), priority, [&](size_t i) { return eventCode; }, [&](size_t i) {
+                return Framework::CreateEventMessage(data[i], eventCode, returnBus);
+            });
+        }
+
+        //! \brief Publishes one event without data for every event code, as a batch.
+        //!
+        //! \param eventCodes The event codes to publish, in order.
+        //! \param returnBus The bus on which a response should be published, if any.
+        //! \param priority The priority of the events, defaults to the priority of the bus.
+        KsResult PublishBatch(
+            std::span<const KsEventCodeType> eventCodes,
+            Bus* returnBus = nullptr,
+            KsEventPriority priority = ks_event_priority_bus
+        ) {
+            return DispatchEach(eventCodes.size(), priority, [&](size_t i) { return eventCodes[i]; }, [&](size_t i) {
+                return Framework::CreateEventMessage(eventCodes[i], returnBus);
+            });
         }
 
         //! \brief Getter for the name of the bus
@@ -79,12 +286,115 @@ namespace kronos {
         //! \return the name of the bus
         [[nodiscard]] const String& GetName() const;
 
+        //! \brief Getter for the default priority of the events published on the bus
+        [[nodiscard]] KsEventPriority GetPriority() const;
+
+        //! \brief Setter for the default priority of the events published on the bus
+        void SetPriority(KsEventPriority priority);
+
+    protected:
+        //! \brief Hands a new message over to every subscriber, each of them receiving one reference to it.
+        //!
+        //! \param message The message to deliver.
+        //! \param priority The priority of the message, ks_event_priority_bus to use the priority of the bus.
+        KsResult Dispatch(EventMessage* message, KsEventPriority priority = ks_event_priority_bus);
+
+        //! \brief Hands a new message over to every subscriber from an interrupt.
+        //!
+        //! \param message The message to deliver.
+        //! \param priority The priority of the message, ks_event_priority_bus to use the priority of the bus.
+        //! \param higherPriorityTaskWoken Set to pdTRUE if a task should be switched to when the interrupt exits.
+        KsResult DispatchFromISR(EventMessage* message, KsEventPriority priority, BaseType_t* higherPriorityTaskWoken);
+
+        //! \brief Hands a batch of new messages over to every subscriber with a single ReceiveEvents() call each.
+        //!
+        //! \param messages The messages to deliver, in order.
+        //! \param priority The priority of the messages, ks_event_priority_bus to use the priority of the bus.
+        KsResult DispatchBatch(std::span<EventMessage*> messages, KsEventPriority priority = ks_event_priority_bus);
+
+        //! \brief Checks whether a subscriber handled an event as expected, even if its policy dropped it.
+        static bool Delivered(KsResult result);
+
+        //! \brief Getter for the subscribers of an event code.
+        //!
+        //! Publishing an event code nobody is interested in returns early, before any message is created.
+        //!
+        //! \return One bit per index in m_Subscriptions, set if the subscription accepts the event code.
+        [[nodiscard]] uint32_t GetRoute(KsEventCodeType eventCode) const {
+            return eventCode < KS_EVENT_FILTER_SIZE ? m_Routes[eventCode] : m_AllRoutes;
+        }
+
+        //! \brief Recomputes the subscribers of every event code after the subscriptions changed.
+        void BuildRoutes();
+
+        //! \brief Calls f with every subscription set in a route.
+        template<typename F>
+        void ForEachRoute(uint32_t route, F&& f) {
+            for (; route != 0; route &= route - 1)
+                f(m_Subscriptions[std::countr_zero(route)]);
+        }
+
+        //! \brief Creates count messages and dispatches them in batches of KS_EVENT_BATCH_SIZE.
+        //!
+        //! \param count The number of messages to publish.
+        //! \param priority The priority of the messages, ks_event_priority_bus to use the priority of the bus.
+        //! \param eventCodeOf Called with the index of each message, returns its event code. Messages nobody
+        //! subscribed to are skipped without being created.
+        //! \param createMessage Called with the index of each message, returns nullptr if it could not be created.
+        template<typename C, typename F>
+        KsResult DispatchEach(size_t count, KsEventPriority priority, C&& eventCodeOf, F&& createMessage) {
+            if (m_Subscriptions.empty()) KS_THROW(ks_error_bus_no_subscribers);
+
+            EventMessage* messages[KS_EVENT_BATCH_SIZE];
+            size_t batchSize = 0;
+            for (size_t i = 0; i < count; i++) {
+                if (GetRoute(eventCodeOf(i)) == 0) continue;
+
+                messages[batchSize] = createMessage(i);
+                if (messages[batchSize] == nullptr) {
+                    // Nothing was dispatched from this batch yet, give back what was created
+                    for (size_t j = 0; j < batchSize; j++)
+                        Framework::ReleaseEventMessage(messages[j]);
+                    KS_THROW(ks_error_event_message_pool_exhausted);
+                }
+
+                if (++batchSize == KS_EVENT_BATCH_SIZE) {
+                    KS_TRY(ks_error_bus_publish, DispatchBatch({ messages, batchSize }, priority));
+                    batchSize = 0;
+                }
+            }
+
+            if (batchSize > 0)
+                KS_TRY(ks_error_bus_publish, DispatchBatch({ messages, batchSize }, priority));
+
+            return ks_success;
+        }
+
     protected:
         //! Name of the bus.
         String m_Name;
 
-        //! A list of components subscribed to the bus.
-        List<ComponentBase*> m_ReceivingComponents;
+        //! Priority of the events published without an explicit priority.
+        KsEventPriority m_Priority;
+
+        //! The components subscribed to the bus, along with how events are delivered to each of them.
+        //! Refers either to m_OwnedSubscriptions or to a static table bound with BindSubscriptions().
+        std::span<Subscription> m_Subscriptions;
+
+        //! Storage of the subscriptions added at runtime.
+        List<Subscription> m_OwnedSubscriptions;
+
+        //! Subscribers of each event code that filters can represent, see GetRoute().
+        uint32_t m_Routes[KS_EVENT_FILTER_SIZE]{};
+        //! Every subscriber, for the event codes filters can't represent.
+        uint32_t m_AllRoutes = 0;
+
+        //! Largest number of subscribers, bounded by the width of a route.
+        static constexpr size_t s_MaxSubscriptions = 32;
+
+        //! Overflow policy of the subscriptions made without one.
+        KsOverflowPolicy m_Overflow = ks_overflow_block;
+        KsTickType m_OverflowTimeout = KS_QUEUE_DEFAULT_WAIT_TIME;
 
     };
 
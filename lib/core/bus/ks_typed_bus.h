@@ -0,0 +1,282 @@
+#pragma once
+
+#include "ks_bus.h"
+
+namespace kronos {
+
+    //! \class LoanPool
+    //! \brief Buffers loaned by a TypedBus, which a publisher can wait for when they are all loaned out.
+    //!
+    //! A counting semaphore tracks the free buffers, so a publisher running ahead of the subscribers blocks in
+    //! Acquire() until one of its earlier buffers is released, the same way a blocking publish waits for room in
+    //! a queue.
+    //!
+    //! \tparam T The type of the buffers.
+    //! \tparam Capacity The number of buffers that can be loaned at the same time.
+    template<typename T, size_t Capacity>
+    class LoanPool {
+    public:
+        LoanPool() {
+#if KS_STATIC_ALLOCATION
+            m_Available = xSemaphoreCreateCountingStatic(Capacity, Capacity, &m_AvailableControl);
+#else
+            m_Available = xSemaphoreCreateCounting(Capacity, Capacity);
+#endif
+        }
+
+        LoanPool(const LoanPool& other) = delete;
+        void operator=(const LoanPool& other) = delete;
+
+        //! \brief Takes a buffer out of the pool, waiting for one to be released if they are all loaned.
+        //!
+        //! \param ticksToWait Ticks to wait for a buffer, never wait from an interrupt.
+        //! \return The buffer, nullptr if none was released in time.
+        T* Acquire(TickType_t ticksToWait) {
+            if (m_Available != nullptr && xSemaphoreTake(m_Available, ticksToWait) != pdPASS) {
+                m_TimedOut.fetch_add(1, std::memory_order_relaxed);
+                return nullptr;
+            }
+
+            return m_Pool.Acquire();
+        }
+
+        //! \brief Gives a buffer back to the pool and wakes a publisher waiting for one.
+        void Release(const T* value) {
+            if (m_Pool.Release(value) == ks_success && m_Available != nullptr) xSemaphoreGive(m_Available);
+        }
+
+        //! \brief Getter for the usage counters of the pool, loans that timed out are counted as exhausted.
+        [[nodiscard]] PoolStats GetStats() const {
+            PoolStats stats = m_Pool.GetStats();
+            stats.exhausted += m_TimedOut.load(std::memory_order_relaxed);
+            return stats;
+        }
+
+    private:
+        Pool<T, Capacity> m_Pool;
+        //! Counts the buffers that aren't loaned
+        SemaphoreHandle_t m_Available = nullptr;
+#if KS_STATIC_ALLOCATION
+        //! Control block of m_Available
+        StaticSemaphore_t m_AvailableControl{};
+#endif
+        std::atomic<uint32_t> m_TimedOut{ 0 };
+    };
+
+    //! \class LoanedBuffer
+    //! \brief A buffer borrowed from the loan pool of a TypedBus.
+    //!
+    //! The publisher fills the buffer in place and hands it back to the bus with TypedBus::Commit(). A buffer that
+    //! is dropped without being committed returns to its pool.
+    //!
+    //! \tparam T The type of the buffer.
+    //! \tparam Capacity The capacity of the pool the buffer was borrowed from.
+    template<typename T, size_t Capacity>
+    class LoanedBuffer {
+    public:
+        LoanedBuffer() = default;
+
+        LoanedBuffer(LoanPool<T, Capacity>* pool, T* value) : m_Pool(pool), m_Value(value) {}
+
+        LoanedBuffer(LoanedBuffer&& other) noexcept : m_Pool(other.m_Pool), m_Value(other.Take()) {}
+
+        LoanedBuffer& operator=(LoanedBuffer&& other) noexcept {
+            if (this != &other) {
+                Return();
+                m_Pool = other.m_Pool;
+                m_Value = other.Take();
+            }
+
+            return *this;
+        }
+
+        ~LoanedBuffer() {
+            Return();
+        }
+
+        LoanedBuffer(const LoanedBuffer& other) = delete;
+        void operator=(const LoanedBuffer& other) = delete;
+
+        //! \brief Gives up ownership of the buffer.
+        T* Take() {
+            return std::exchange(m_Value, nullptr);
+        }
+
+        T& operator*() { return *m_Value; }
+        T* operator->() { return m_Value; }
+
+        //! \brief Checks whether a buffer was available when the loan was made.
+        explicit operator bool() const { return m_Value != nullptr; }
+
+    private:
+        void Return() {
+            if (m_Value != nullptr)
+                m_Pool->Release(Take());
+        }
+
+    private:
+        LoanPool<T, Capacity>* m_Pool = nullptr;
+        T* m_Value = nullptr;
+    };
+
+    //! \class TypedBus
+    //! \brief A bus restricted to a single payload type and a fixed set of event codes.
+    //!
+    //! Publishing data of another type, or with an event code the bus was not declared with, fails to compile.
+    //! Since every message on the bus is known to carry a Payload, subscribers read it back through Read()
+    //! without having to name the type again. A TypedBus is still a Bus: it is created through
+    //! Framework::CreateBus() and delivers to the same component queues.
+    //!
+    //! Large payloads can be published without any copy: the publisher borrows a buffer with Loan(), fills it in
+    //! place and passes it to Commit(). Every subscriber then reads that same buffer, which returns to the loan
+    //! pool once the last subscriber has released the message. The loan pool holds KS_BUS_LOAN_COUNT buffers and
+    //! is only allocated for bus types that actually make loans. A publisher that has every buffer loaned out
+    //! waits in Loan() for the subscribers to release one.
+    //!
+    //! \tparam Payload The type of the data carried by every event of the bus.
+    //! \tparam Codes The event codes that can be published on the bus.
+    template<typename Payload, KsEventCodeType... Codes>
+    class TypedBus : public Bus {
+        static_assert(sizeof...(Codes) > 0, "A typed bus must carry at least one event code!");
+
+    public:
+        //! The type of the data carried by the bus
+        using PayloadType = Payload;
+        //! A buffer borrowed from the loan pool of the bus
+        using Loaned = LoanedBuffer<Payload, KS_BUS_LOAN_COUNT>;
+
+        //! \copydoc Bus::Bus
+        explicit TypedBus(String name, KsEventPriority priority = ks_event_priority_normal)
+            : Bus(std::move(name), priority) {}
+
+        //! \brief Checks at compile time whether the bus carries an event code.
+        template<KsEventCodeType Code>
+        static constexpr bool Carries() {
+            return ((Code == Codes) || ...);
+        }
+
+        //! \brief Publishes an event to every subscriber of the bus.
+        //!
+        //! \tparam Code The event code, it must be one of the codes of the bus.
+        //! \param data The data carried by the event, it must be of the payload type of the bus.
+        //! \param returnBus The bus on which a response should be published, if any.
+        //! \param priority The priority of the event, defaults to the priority of the bus.
+        template<KsEventCodeType Code, typename T>
+        KsResult Publish(T&& data, Bus* returnBus = nullptr, KsEventPriority priority = ks_event_priority_bus) {
+            static_assert(std::is_same_v<std::decay_t<T>, Payload>, "Data doesn't match the payload type of the bus!");
+            static_assert(Carries<Code>(), "Event code isn't carried by the bus!");
+
+            return Bus::Publish(std::forward<T>(data), Code, returnBus, priority);
+        }
+
+        //! \brief Publishes an event from an interrupt. See Bus::PublishFromISR().
+        //!
+        //! \tparam Code The event code, it must be one of the codes of the bus.
+        template<KsEventCodeType Code, typename T>
+        KsResult PublishFromISR(
+            T&& data,
+            BaseType_t* higherPriorityTaskWoken,
+            KsEventPriority priority = ks_event_priority_bus
+        ) {
+            static_assert(std::is_same_v<std::decay_t<T>, Payload>, "Data doesn't match the payload type of the bus!");
+            static_assert(Carries<Code>(), "Event code isn't carried by the bus!");
+
+            return Bus::PublishFromISR(std::forward<T>(data), Code, higherPriorityTaskWoken, priority);
+        }
+
+        //! \brief Borrows a buffer from the loan pool of the bus.
+        //!
+        //! \param ticksToWait Ticks to wait for a buffer to be released when they are all loaned out.
+        //! \return The buffer, check it with operator bool as the pool may stay exhausted.
+        Loaned Loan(TickType_t ticksToWait = KS_BUS_LOAN_WAIT_TIME) {
+            return { &s_Loans, s_Loans.Acquire(ticksToWait) };
+        }
+
+        //! \brief Publishes a loaned buffer to every subscriber of the bus without copying it.
+        //!
+        //! \tparam Code The event code, it must be one of the codes of the bus.
+        //! \param buffer A buffer obtained from Loan(), the bus takes it over.
+        //! \param returnBus The bus on which a response should be published, if any.
+        //! \param priority The priority of the event, defaults to the priority of the bus.
+        template<KsEventCodeType Code>
+        KsResult Commit(Loaned&& buffer, Bus* returnBus = nullptr, KsEventPriority priority = ks_event_priority_bus) {
+            static_assert(Carries<Code>(), "Event code isn't carried by the bus!");
+
+            if (!buffer) KS_THROW(ks_error_bus_loan_exhausted);
+            if (m_Subscriptions.empty()) KS_THROW(ks_error_bus_no_subscribers);
+            if (GetRoute(Code) == 0) return ks_success;
+
+            EventMessage* message = Framework::CreateEventMessage(Code, returnBus);
+            if (message == nullptr) KS_THROW(ks_error_event_message_pool_exhausted);
+
+            message->data.Adopt<Payload>(buffer.Take(), &ReturnLoan);
+            return Dispatch(message, priority);
+        }
+
+        //! \brief Publishes a batch of events, one per element of data.
+        //!
+        //! \tparam Code The event code, it must be one of the codes of the bus.
+        //! \param data The data carried by each event.
+        //! \param returnBus The bus on which a response should be published, if any.
+        //! \param priority The priority of the events, defaults to the priority of the bus.
+        template<KsEventCodeType Code>
+        KsResult PublishBatch(
+            std::span<const Payload> data,
+            Bus* returnBus = nullptr,
+            KsEventPriority priority = ks_event_priority_bus
+        ) {
+            static_assert(Carries<Code>(), "Event code isn't carried by the bus!");
+
+            return Bus::PublishBatch<Payload>(data, Code, returnBus, priority);
+        }
+
+        //! \brief Publishes a batch of loaned buffers without copying them.
+        //!
+        //! \tparam Code The event code, it must be one of the codes of the bus.
+        //! \param buffers Buffers obtained from Loan(), the bus takes them over.
+        //! \param returnBus The bus on which a response should be published, if any.
+        //! \param priority The priority of the events, defaults to the priority of the bus.
+        template<KsEventCodeType Code>
+        KsResult CommitBatch(
+            std::span<Loaned> buffers,
+            Bus* returnBus = nullptr,
+            KsEventPriority priority = ks_event_priority_bus
+        ) {
+            static_assert(Carries<Code>(), "Event code isn't carried by the bus!");
+
+            for (const auto& buffer: buffers) {
+                if (!buffer) KS_THROW(ks_error_bus_loan_exhausted);
+            }
+
+            return DispatchEach(buffers.size(), priority, [&](size_t i) { return Code; }, [&](size_t i) {
+                EventMessage* message = Framework::CreateEventMessage(Code, returnBus);
+                if (message != nullptr)
+                    message->data.Adopt<Payload>(buffers[i].Take(), &ReturnLoan);
+
+                return message;
+            });
+        }
+
+        //! \brief Getter for the usage counters of the loan pool of the bus.
+        static PoolStats GetLoanStats() {
+            return s_Loans.GetStats();
+        }
+
+        //! \brief Accesses the data of an event received from this bus.
+        //!
+        //! \param message An event message published on a bus of this type.
+        //! \return A read-only reference to the data shared by every subscriber.
+        static const Payload& Read(const EventMessage& message) {
+            return message.Cast<Payload>();
+        }
+
+    private:
+        static void ReturnLoan(void* value, void* owner) {
+            s_Loans.Release(static_cast<Payload*>(value));
+        }
+
+        //! Buffers loaned to publishers, shared by every bus of this type
+        static inline LoanPool<Payload, KS_BUS_LOAN_COUNT> s_Loans{};
+    };
+
+}
@@ -4,14 +4,29 @@
 
 namespace kronos {
 
-    ComponentActive::ComponentActive(const String& name, KsTickType queueTicksToWait, size_t stackSize, uint16_t priority)
-        : ComponentQueued(name, queueTicksToWait), m_StackSize(stackSize), m_Priority(priority) {}
+    ComponentActive::ComponentActive(
+        const String& name,
+        KsTickType queueTicksToWait,
+        size_t stackSize,
+        uint16_t priority,
+        size_t queueSize
+    ) : ComponentQueued(name, queueTicksToWait, queueSize), m_StackSize(stackSize), m_Priority(priority) {}
 
     void ComponentActive::Start(void* data) {
         static_cast<ComponentActive*>(data)->Run();
     }
 
     KsResult ComponentActive::Init() {
+        KS_TRY(ks_error_component_initialize, ComponentQueued::Init());
+
+#if KS_STATIC_ALLOCATION
+        // The stack comes from the static arena and the control block is part of the component
+        auto* stack = static_cast<StackType_t*>(StaticArena::Allocate(m_StackSize * sizeof(StackType_t)));
+        if (stack == nullptr) KS_THROW(ks_error_static_arena_exhausted);
+
+        m_Task = xTaskCreateStatic(Start, m_Name.data(), m_StackSize, this, m_Priority, stack, &m_TaskControl);
+        if (m_Task == nullptr) KS_THROW(ks_error_component_task_create);
+#else
         // Create Task
         if(xTaskCreate(
             Start,          // The function that implements the task.
@@ -23,10 +38,19 @@ namespace kronos {
         ) != pdPASS) {
             KS_THROW(ks_error_component_task_create);
         }
+#endif
 
         return ks_success;
     }
 
+    MemoryBudget ComponentActive::GetMemoryBudget() const {
+        MemoryBudget budget = ComponentQueued::GetMemoryBudget();
+        budget.stack += m_StackSize * sizeof(StackType_t);
+        budget.control += sizeof(StaticTask_t);
+
+        return budget;
+    }
+
     KsResult ComponentActive::Destroy() {
         vTaskDelete(m_Task);
         return ks_success;
@@ -34,24 +58,66 @@ namespace kronos {
 
     void ComponentActive::Run() {
         while (true) {
-            const EventMessage* message;
-            if (m_Queue->Pop(&message, 0) == ks_success) {
-                ProcessEvent(*message);
-                Framework::DeleteEventMessage(message);
+            // Blocks until an event is queued or the period is due
+            size_t count = PopEvents(GetTicksToWait());
+
+            KsTickType start = BeginWork();
+            if (count > 0) {
+                ProcessEventBatch();
 
 //                if(result.HasError()) {
 //                    TODO: Handle the errors
 //                }
             }
-            taskYIELD()
+            EndWork(start);
         }
     }
 
+    KsResult ComponentActive::ProcessPeriodic() {
+        return ks_success;
+    }
+
+    void ComponentActive::SetPeriod(KsTickType period) {
+        m_Period = period;
+        m_Deadline = xTaskGetTickCount() + period;
+    }
+
+    const RunStats& ComponentActive::GetRunStats() const {
+        return m_RunStats;
+    }
+
+    KsTickType ComponentActive::GetTicksToWait() const {
+        if (m_Period == portMAX_DELAY) return portMAX_DELAY;
+
+        // Compared as a difference so that the tick count can wrap around
+        auto remaining = static_cast<int32_t>(m_Deadline - xTaskGetTickCount());
+        return remaining > 0 ? static_cast<KsTickType>(remaining) : 0;
+    }
+
+    KsTickType ComponentActive::BeginWork() {
+        m_RunStats.wakeups.fetch_add(1, std::memory_order_relaxed);
+        return xTaskGetTickCount();
+    }
+
+    void ComponentActive::EndWork(KsTickType start) {
+        if (m_Period != portMAX_DELAY && static_cast<int32_t>(start - m_Deadline) >= 0) {
+            ProcessPeriodic();
+
+            // Periods that were missed entirely are skipped rather than run back to back
+            m_Deadline += m_Period;
+            if (static_cast<int32_t>(start - m_Deadline) >= 0)
+                m_Deadline = start + m_Period;
+        }
+
+        m_RunStats.busyTicks.fetch_add(xTaskGetTickCount() - start, std::memory_order_relaxed);
+    }
+
     KsResult ComponentActive::ProcessEvent(const EventMessage& message) {
         switch (message.eventCode) {
             case ks_event_health_ping:
                 if (message.returnBus != nullptr) {
-                    KS_TRY(ks_error_component_process_event, message.returnBus->Publish(
+                    KS_TRY(ks_error_component_process_event, Bus::Reply(
+                        message,
                         this,
                         ks_event_health_pong
                     ));
@@ -14,10 +14,20 @@
 
 namespace kronos {
 
+    //! \struct RunStats
+    //! \brief Counters describing how the task of an active component spends its time.
+    struct RunStats {
+        //! Number of times the task woke up, either for events or for its period
+        std::atomic<uint32_t> wakeups{ 0 };
+        //! Ticks spent processing after a wake up, the rest of the time the task is blocked
+        std::atomic<uint32_t> busyTicks{ 0 };
+    };
+
     //! \class ComponentActive
     //! \brief A class that implements the base of an active component
     //!
-    //! This class is used as the basic block for all active components
+    //! This class is used as the basic block for all active components. The task blocks on the queue of the
+    //! component and only runs when an event arrives or when its period elapses, it never polls.
     class ComponentActive : public ComponentQueued {
     public:
         //! \brief Creates a new activate component
@@ -25,11 +35,13 @@ namespace kronos {
         //! \param name the name of the component
         //! \param stackSize The number of words (not bytes!) to allocate for use as the task's stack
         //! \param priority the priority at which the created task will execute
+        //! \param queueSize length of the low and normal priority lanes of the queue, see ComponentQueued
         explicit ComponentActive(
             const String& name,
             KsTickType queueTicksToWait = 0,
             size_t stackSize = KS_COMPONENT_STACK_SIZE_SMALL,
-            uint16_t priority = KS_COMPONENT_PRIORITY_MEDIUM
+            uint16_t priority = KS_COMPONENT_PRIORITY_MEDIUM,
+            size_t queueSize = KS_QUEUE_DEFAULT_SIZE
         );
 
         //! @copydoc
@@ -38,17 +50,48 @@ namespace kronos {
         //! @copydoc
         KsResult Destroy() override;
 
+        //! \brief Adds the stack and control block of the task to the memory of the queue.
+        [[nodiscard]] MemoryBudget GetMemoryBudget() const override;
+
         //! Function containing main loop for the event processing thread.
         [[noreturn]] virtual void Run();
 
         //! @copydoc
         KsResult ProcessEvent(const EventMessage& message) override;
 
+        //! \brief Called by the task every period, see SetPeriod().
+        virtual KsResult ProcessPeriodic();
+
+        //! \brief Sets the period at which ProcessPeriodic() is called, in between events.
+        //!
+        //! \param period Ticks between two calls, portMAX_DELAY to only wake up for events.
+        void SetPeriod(KsTickType period);
+
+        //! \brief Getter for the wake up and busy time counters of the task.
+        [[nodiscard]] const RunStats& GetRunStats() const;
+
+    protected:
+        //! \brief Ticks the task can block for before its next period is due.
+        [[nodiscard]] KsTickType GetTicksToWait() const;
+
+        //! \brief Marks the start of the work done after a wake up.
+        //!
+        //! \return The tick at which the work started, to give to EndWork().
+        KsTickType BeginWork();
+
+        //! \brief Runs ProcessPeriodic() if the period is due and accounts for the time spent since BeginWork().
+        void EndWork(KsTickType start);
+
     private:
         //! Stack size provided to the task
         size_t m_StackSize;
         //! Priority of the task
         uint16_t m_Priority;
+        //! Ticks between two calls to ProcessPeriodic(), portMAX_DELAY if there is no period
+        KsTickType m_Period = portMAX_DELAY;
+        //! Tick at which ProcessPeriodic() is due next
+        KsTickType m_Deadline = 0;
+        RunStats m_RunStats;
 
         //! \brief Starts the thread
         //!
@@ -58,6 +101,10 @@ namespace kronos {
     protected:
         //! Task handle used to manipulate the task created by the FreeRTOS API
         TaskHandle_t m_Task = nullptr;
+#if KS_STATIC_ALLOCATION
+        //! Control block of the task
+        StaticTask_t m_TaskControl{};
+#endif
     };
 
 }
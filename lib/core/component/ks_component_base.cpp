@@ -1,4 +1,5 @@
 #include "ks_component_base.h"
+#include "ks_framework.h"
 
 namespace kronos {
 
@@ -9,5 +10,35 @@ namespace kronos {
         return m_Name;
     }
 
+    MemoryBudget ComponentBase::GetMemoryBudget() const {
+        return {};
+    }
+
+    KsResult ComponentBase::ReceiveEventFromISR(
+        const EventMessage* message,
+        const Subscription& subscription,
+        BaseType_t* higherPriorityTaskWoken
+    ) {
+        subscription.stats.dropped.fetch_add(1, std::memory_order_relaxed);
+        Framework::ReleaseEventMessage(message);
+        return ks_error_component_receive_event;
+    }
+
+    KsResult ComponentBase::ReceiveEvents(
+        std::span<const EventMessage* const> messages,
+        const Subscription& subscription
+    ) {
+        bool received = true;
+        for (auto message: messages) {
+            KsResult result = ReceiveEvent(message, subscription);
+            if (result != ks_success && result != ks_error_component_event_dropped)
+                received = false;
+        }
+
+        if (!received) KS_THROW(ks_error_component_receive_event);
+
+        return ks_success;
+    }
+
 }
 
@@ -7,25 +7,125 @@
 namespace kronos {
 
     class Bus;
+    class ComponentBase;
 
     //! \struct EventMessage
     //! \brief A struct that holds information about an event message
     //!
-    //! This struct holds information about the event message such as the code, the data, and the return bus
+    //! This struct holds information about the event message such as the code, the data, and the return bus.
+    //! A single message is shared by every subscriber of the bus it was published on, so it is immutable once
+    //! published and only given back to the framework when the last subscriber releases it.
     struct EventMessage {
         //! Identifier for the event. This allows the user to process the event properly
         KsEventCodeType eventCode = ks_event_invalid;
         //! The data being passed through the event
-        std::any data{};
+        Payload data{};
         //! The return bus. This is only used for asynchronous buses as synchronous buses allow you to return values right away
         Bus* returnBus = nullptr;
+        //! Priority lane the event is queued in by the subscribers
+        KsEventPriority priority = ks_event_priority_normal;
+        //! Identifier shared by a request and its response, see AsyncCall
+        KsCorrelationIdType correlationId = 0;
+        //! Number of subscribers that still have to release the message
+        mutable std::atomic<uint16_t> references{ 1 };
 
+        //! \brief Accesses the data of the event.
+        //!
+        //! \tparam T The type of the data, it must match the type that was published.
         template<typename T>
-        T Cast() const {
-            return std::any_cast<T>(data);
+        const T& Cast() const {
+            return data.Get<T>();
         }
     };
 
+    //! \enum KsOverflowPolicy
+    //! \brief What a subscriber does with an event when its queue is full.
+    enum KsOverflowPolicy : uint8_t {
+        //! Wait for room up to the timeout of the subscription, then drop the new event
+        ks_overflow_block,
+        //! Drop the new event right away
+        ks_overflow_drop_newest,
+        //! Make room by dropping the oldest event waiting in the same lane
+        ks_overflow_drop_oldest,
+        //! Keep at most one waiting event per event code, merging the others into it
+        ks_overflow_coalesce,
+    };
+
+    //! \struct DeliveryStats
+    //! \brief Counters of what happened to the events published to a subscriber.
+    struct DeliveryStats {
+        //! Events handed to the subscriber
+        std::atomic<uint32_t> delivered{ 0 };
+        //! New events dropped because the queue was full
+        std::atomic<uint32_t> dropped{ 0 };
+        //! Waiting events dropped to make room for newer ones
+        std::atomic<uint32_t> evicted{ 0 };
+        //! Events merged into one with the same code that was already waiting
+        std::atomic<uint32_t> coalesced{ 0 };
+
+        DeliveryStats() = default;
+
+        DeliveryStats(const DeliveryStats& other)
+            : delivered(other.delivered.load()), dropped(other.dropped.load()),
+              evicted(other.evicted.load()), coalesced(other.coalesced.load()) {}
+    };
+
+    //! \class EventFilter
+    //! \brief The set of event codes a subscriber wants to receive from a bus.
+    //!
+    //! A default constructed filter accepts every event code. Only the codes below KS_EVENT_FILTER_SIZE can be
+    //! filtered, higher codes are always accepted.
+    class EventFilter {
+    public:
+        //! \brief Creates a filter accepting every event code.
+        constexpr EventFilter() = default;
+
+        //! \brief Creates a filter accepting only the given event codes.
+        constexpr EventFilter(std::initializer_list<KsEventCodeType> eventCodes) : m_All(false) {
+            for (auto eventCode: eventCodes)
+                Add(eventCode);
+        }
+
+        //! \brief Accepts one more event code.
+        constexpr EventFilter& Add(KsEventCodeType eventCode) {
+            if (eventCode < KS_EVENT_FILTER_SIZE)
+                m_Bits[eventCode / 32] |= 1u << (eventCode % 32);
+            return *this;
+        }
+
+        //! \brief Accepts every event code accepted by another filter.
+        constexpr EventFilter& Add(const EventFilter& other) {
+            m_All = m_All || other.m_All;
+            for (size_t i = 0; i < std::size(m_Bits); i++)
+                m_Bits[i] |= other.m_Bits[i];
+            return *this;
+        }
+
+        //! \brief Checks whether an event code passes the filter.
+        [[nodiscard]] constexpr bool Matches(KsEventCodeType eventCode) const {
+            return m_All || eventCode >= KS_EVENT_FILTER_SIZE || (m_Bits[eventCode / 32] & (1u << (eventCode % 32)));
+        }
+
+    private:
+        uint32_t m_Bits[(KS_EVENT_FILTER_SIZE + 31) / 32]{};
+        bool m_All = true;
+    };
+
+    //! \struct Subscription
+    //! \brief A component subscribed to a bus, along with how events are delivered to it.
+    struct Subscription {
+        //! The subscribed component
+        ComponentBase* component = nullptr;
+        //! The event codes delivered to the component
+        EventFilter events{};
+        //! What happens when the queue of the component is full
+        KsOverflowPolicy overflow = ks_overflow_block;
+        //! Ticks to wait for room in the queue, only used by ks_overflow_block
+        KsTickType timeout = KS_QUEUE_DEFAULT_WAIT_TIME;
+        //! Delivery counters, updated by the component
+        mutable DeliveryStats stats{};
+    };
+
     //! \class ComponentBase
     //! \brief A class that implements the base of all components
     //!
@@ -57,14 +157,47 @@ namespace kronos {
 
         //! \brief Receives the event from the publishing bus
         //!
+        //! The component takes over one reference to the message and must release it through
+        //! Framework::ReleaseEventMessage() once processed, even if it could not accept the message.
+        //!
         //! \param message the event message containing the information being published on the bus
-        virtual KsResult ReceiveEvent(const EventMessage* message) = 0;
+        //! \param subscription the subscription the event is delivered through, its counters are updated
+        //! \return ks_error_component_event_dropped if the event was dropped as the subscription allows
+        virtual KsResult ReceiveEvent(const EventMessage* message, const Subscription& subscription) = 0;
+
+        //! \brief Receives a batch of events from the publishing bus
+        //!
+        //! The component takes over one reference to every message, as with ReceiveEvent(). The default
+        //! implementation receives the events one by one.
+        //!
+        //! \param messages the event messages published on the bus, in publish order
+        //! \param subscription the subscription the events are delivered through, its counters are updated
+        virtual KsResult ReceiveEvents(std::span<const EventMessage* const> messages, const Subscription& subscription);
+
+        //! \brief Receives an event published from an interrupt
+        //!
+        //! Must not block nor use the stack trace. The component takes over one reference to the message. The
+        //! default implementation rejects the event, as only queued components can defer it to a task.
+        //!
+        //! \param message the event message published on the bus
+        //! \param subscription the subscription the event is delivered through, its counters are updated
+        //! \param higherPriorityTaskWoken set to pdTRUE if a task should be switched to when the interrupt exits
+        virtual KsResult ReceiveEventFromISR(
+            const EventMessage* message,
+            const Subscription& subscription,
+            BaseType_t* higherPriorityTaskWoken
+        );
 
         //! \brief Processes the event message
         //!
         //! \param message the event message containing the information that was published to the bus
         virtual KsResult ProcessEvent(const EventMessage& message) = 0;
 
+        //! \brief Getter for the memory the component reserved for its task, queues and kernel objects
+        //!
+        //! The default implementation reports nothing, as a plain component owns no kernel object.
+        [[nodiscard]] virtual MemoryBudget GetMemoryBudget() const;
+
         //! \brief gets the name of the component
         //! \return
         [[nodiscard]] const String& GetName() const;
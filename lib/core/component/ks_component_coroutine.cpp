@@ -0,0 +1,218 @@
+#include "ks_component_coroutine.h"
+#include "ks_framework.h"
+
+namespace kronos {
+
+    //! A block of the frame pool
+    struct CoroutineFrame {
+        alignas(std::max_align_t) uint8_t data[KS_COROUTINE_FRAME_SIZE];
+    };
+
+    //! Frames of every coroutine, shared by all the coroutine components
+    static Pool<CoroutineFrame, KS_COROUTINE_FRAME_COUNT> s_Frames{};
+
+    void* CoroutineTask::promise_type::operator new(size_t size) noexcept {
+        KS_ASSERT(size <= sizeof(CoroutineFrame), "Coroutine frame is larger than KS_COROUTINE_FRAME_SIZE!")
+        if (size > sizeof(CoroutineFrame)) return nullptr;
+
+        return s_Frames.Acquire();
+    }
+
+    void CoroutineTask::promise_type::operator delete(void* frame) noexcept {
+        s_Frames.Release(static_cast<CoroutineFrame*>(frame));
+    }
+
+    PoolStats CoroutineTask::GetFramePoolStats() {
+        return s_Frames.GetStats();
+    }
+
+    void Completion::Signal(KsResult result) {
+        Signal(result, false, nullptr);
+    }
+
+    void Completion::SignalFromISR(BaseType_t* higherPriorityTaskWoken, KsResult result) {
+        Signal(result, true, higherPriorityTaskWoken);
+    }
+
+    void Completion::Signal(KsResult result, bool fromISR, BaseType_t* higherPriorityTaskWoken) {
+        m_Result = result;
+        m_Signaled.store(true);
+
+        // Pairs with the awaiter setting the waiter before checking the signal, one of them sees the other
+        ComponentCoroutine* waiter = m_Waiter.load();
+        if (waiter != nullptr) waiter->Wake(fromISR, higherPriorityTaskWoken);
+    }
+
+    void Completion::Reset() {
+        m_Signaled.store(false);
+        m_Waiter.store(nullptr);
+        m_Result = ks_success;
+    }
+
+    bool Completion::IsSignaled() const {
+        return m_Signaled.load();
+    }
+
+    KsResult Completion::GetResult() const {
+        return m_Result;
+    }
+
+    ComponentCoroutine::ComponentCoroutine(const String& name) : ComponentQueued(name) {}
+
+    KsResult ComponentCoroutine::Init() {
+        KS_TRY(ks_error_component_initialize, ComponentQueued::Init());
+
+#if KS_STATIC_ALLOCATION
+        m_Timer = xTimerCreateStatic(m_Name.data(), 1, pdFALSE, this, TimerStub, &m_TimerControl);
+#else
+        m_Timer = xTimerCreate(m_Name.data(), 1, pdFALSE, this, TimerStub);
+#endif
+        if (m_Timer == nullptr) KS_THROW(ks_error_coroutine_timer);
+
+        m_Main = Main();
+        if (!m_Main) KS_THROW(ks_error_coroutine_frame_exhausted);
+
+        m_Wait = ks_coroutine_wait_start;
+        Wake();
+
+        return ks_success;
+    }
+
+    KsResult ComponentCoroutine::Destroy() {
+        if (m_Timer != nullptr) xTimerDelete(m_Timer, 0);
+        m_Main = {};
+
+        return ComponentQueued::Destroy();
+    }
+
+    MemoryBudget ComponentCoroutine::GetMemoryBudget() const {
+        MemoryBudget budget = ComponentQueued::GetMemoryBudget();
+        budget.control += sizeof(StaticTimer_t);
+
+        return budget;
+    }
+
+    KsResult ComponentCoroutine::ProcessEventQueue(size_t eventBudget, KsTickType timeBudget) {
+        KsTickType start = xTaskGetTickCount();
+        KsTickType elapsed = 0;
+        size_t processed = 0;
+        KsResult result = ks_success;
+
+        while (processed < eventBudget && elapsed < timeBudget) {
+            KsCoroutineWait wait = m_Wait;
+
+            if (IsWaitOver()) {
+                Resume();
+            } else if (wait == ks_coroutine_wait_event || wait == ks_coroutine_wait_done) {
+                // One event at a time, the coroutine may stop awaiting events after any of them
+                if (PopEvents(m_QueueTicksToWait, 1) == 0) break;
+
+                result = ProcessEventBatch();
+                if (result != ks_success) break;
+            } else {
+                break;
+            }
+
+            processed++;
+            elapsed = xTaskGetTickCount() - start;
+        }
+
+        RecordVisit(processed, elapsed, (processed >= eventBudget || elapsed >= timeBudget) && HasWork());
+
+        KS_TRY(ks_error_component_process_event, result);
+        return ks_success;
+    }
+
+    KsResult ComponentCoroutine::ProcessEvent(const EventMessage& message) {
+        if (m_Wait == ks_coroutine_wait_event) {
+            m_Event = &message;
+            Resume();
+            m_Event = nullptr;
+        }
+
+        return ks_success;
+    }
+
+    KsCoroutineWait ComponentCoroutine::GetWait() const {
+        return m_Wait;
+    }
+
+    bool ComponentCoroutine::HasWork() const {
+        KsCoroutineWait wait = m_Wait;
+        if (wait == ks_coroutine_wait_event || wait == ks_coroutine_wait_done) return HasPendingEvents();
+
+        return IsWaitOver();
+    }
+
+    bool ComponentCoroutine::IsWaitOver() const {
+        switch (m_Wait) {
+            case ks_coroutine_wait_start:
+                return true;
+            case ks_coroutine_wait_timer:
+                return m_TimerFired.load(std::memory_order_acquire);
+            case ks_coroutine_wait_completion:
+                return m_Completion->IsSignaled();
+            default:
+                return false;
+        }
+    }
+
+    void ComponentCoroutine::Resume() {
+        std::coroutine_handle<> handle = m_Wait == ks_coroutine_wait_start ? m_Main.m_Handle : m_Suspended;
+
+        // The awaiter the coroutine suspends on next sets what it waits for
+        m_Wait = ks_coroutine_wait_running;
+        handle.resume();
+
+        if (m_Main.IsDone()) m_Wait = ks_coroutine_wait_done;
+    }
+
+    void ComponentCoroutine::TimerStub(TimerHandle_t timerHandle) {
+        auto* component = static_cast<ComponentCoroutine*>(pvTimerGetTimerID(timerHandle));
+
+        component->m_TimerFired.store(true, std::memory_order_release);
+        component->Wake();
+    }
+
+    ComponentCoroutine::EventAwaiter ComponentCoroutine::NextEvent() {
+        return { this };
+    }
+
+    ComponentCoroutine::SleepAwaiter ComponentCoroutine::Sleep(KsTickType ticks) {
+        return { this, ticks };
+    }
+
+    ComponentCoroutine::CompletionAwaiter ComponentCoroutine::Await(Completion& completion) {
+        return { this, &completion };
+    }
+
+    void ComponentCoroutine::EventAwaiter::await_suspend(std::coroutine_handle<> handle) noexcept {
+        component->m_Suspended = handle;
+        component->m_Wait = ks_coroutine_wait_event;
+    }
+
+    const EventMessage& ComponentCoroutine::EventAwaiter::await_resume() const noexcept {
+        return *component->m_Event;
+    }
+
+    void ComponentCoroutine::SleepAwaiter::await_suspend(std::coroutine_handle<> handle) noexcept {
+        component->m_Suspended = handle;
+        component->m_TimerFired.store(false, std::memory_order_relaxed);
+        component->m_Wait = ks_coroutine_wait_timer;
+
+        // Changing the period also starts the timer. Without a timer the coroutine resumes on the next visit.
+        if (xTimerChangePeriod(component->m_Timer, ticks, 0) != pdPASS) {
+            result = ks_error_coroutine_timer;
+            component->m_TimerFired.store(true, std::memory_order_release);
+        }
+    }
+
+    void ComponentCoroutine::CompletionAwaiter::await_suspend(std::coroutine_handle<> handle) noexcept {
+        component->m_Suspended = handle;
+        component->m_Completion = completion;
+        component->m_Wait = ks_coroutine_wait_completion;
+
+        // A signal that came in before the waiter was set is caught by the worker checking the wait again
+        completion->m_Waiter.store(component);
+    }
+}
@@ -0,0 +1,282 @@
+// ==================================================================================
+// \title ks_component_coroutine.h
+// \brief A queued component whose logic is written as a coroutine.
+// ==================================================================================
+
+#pragma once
+
+// Kronos includes
+#include "ks_component_queued.h"
+
+// Kernel includes
+#include "FreeRTOS.h"
+#include "timers.h"
+
+namespace kronos {
+    class ComponentCoroutine;
+
+    //! \class CoroutineTask
+    //! \brief A coroutine run by a ComponentCoroutine, either its Main() or a handler awaited by it.
+    //!
+    //! Frames are allocated from a pool of KS_COROUTINE_FRAME_COUNT blocks of KS_COROUTINE_FRAME_SIZE bytes,
+    //! never from the heap. A coroutine whose frame doesn't fit in a block, or that finds the pool empty, is
+    //! returned empty: check it with operator bool. Awaiting a task runs it until it completes, then resumes the
+    //! coroutine that awaited it. An empty task completes right away without running.
+    class CoroutineTask {
+    private:
+        //! Hands control back to the awaiting coroutine, or to whoever resumed the task if nothing awaits it
+        struct FinalAwaiter {
+            [[nodiscard]] bool await_ready() const noexcept { return false; }
+
+            template<typename Promise>
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+                std::coroutine_handle<> continuation = handle.promise().continuation;
+                return continuation ? continuation : std::noop_coroutine();
+            }
+
+            void await_resume() const noexcept {}
+        };
+
+    public:
+        struct promise_type {
+            //! Coroutine resumed when this one completes, if it was awaited
+            std::coroutine_handle<> continuation{};
+
+            CoroutineTask get_return_object() noexcept {
+                return CoroutineTask(std::coroutine_handle<promise_type>::from_promise(*this));
+            }
+
+            static CoroutineTask get_return_object_on_allocation_failure() noexcept { return {}; }
+
+            std::suspend_always initial_suspend() noexcept { return {}; }
+            FinalAwaiter final_suspend() noexcept { return {}; }
+            void return_void() noexcept {}
+            void unhandled_exception() noexcept {}
+
+            static void* operator new(size_t size) noexcept;
+            static void operator delete(void* frame) noexcept;
+        };
+
+        CoroutineTask() = default;
+
+        CoroutineTask(CoroutineTask&& other) noexcept : m_Handle(std::exchange(other.m_Handle, {})) {}
+
+        CoroutineTask& operator=(CoroutineTask&& other) noexcept {
+            if (this != &other) {
+                Destroy();
+                m_Handle = std::exchange(other.m_Handle, {});
+            }
+
+            return *this;
+        }
+
+        ~CoroutineTask() {
+            Destroy();
+        }
+
+        CoroutineTask(const CoroutineTask& other) = delete;
+        void operator=(const CoroutineTask& other) = delete;
+
+        //! \brief Checks whether a frame was available when the coroutine was created.
+        explicit operator bool() const { return static_cast<bool>(m_Handle); }
+
+        //! \brief Checks whether the coroutine ran to completion, an empty task is always done.
+        [[nodiscard]] bool IsDone() const { return !m_Handle || m_Handle.done(); }
+
+        [[nodiscard]] bool await_ready() const noexcept { return IsDone(); }
+
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+            m_Handle.promise().continuation = awaiting;
+            return m_Handle;
+        }
+
+        void await_resume() const noexcept {}
+
+        //! \brief Getter for the usage counters of the frame pool shared by every coroutine.
+        static PoolStats GetFramePoolStats();
+
+    private:
+        friend class ComponentCoroutine;
+
+        explicit CoroutineTask(std::coroutine_handle<promise_type> handle) : m_Handle(handle) {}
+
+        void Destroy() {
+            if (m_Handle) std::exchange(m_Handle, {}).destroy();
+        }
+
+    private:
+        std::coroutine_handle<promise_type> m_Handle{};
+    };
+
+    //! \class Completion
+    //! \brief Signals the end of an operation, such as an I/O transfer, to the coroutine awaiting it.
+    //!
+    //! The operation calls Signal(), or SignalFromISR() from its interrupt, once it is done. A coroutine awaits it
+    //! with ComponentCoroutine::Await(), which returns right away if the completion was already signaled.
+    class Completion {
+    public:
+        Completion() = default;
+
+        Completion(const Completion& other) = delete;
+        void operator=(const Completion& other) = delete;
+
+        //! \brief Marks the operation as done and wakes the component awaiting it.
+        //!
+        //! \param result The result returned to the awaiting coroutine.
+        void Signal(KsResult result = ks_success);
+
+        //! \brief Marks the operation as done from an interrupt. See Signal().
+        void SignalFromISR(BaseType_t* higherPriorityTaskWoken, KsResult result = ks_success);
+
+        //! \brief Prepares the completion for a new operation.
+        void Reset();
+
+        //! \brief Checks whether the operation is done.
+        [[nodiscard]] bool IsSignaled() const;
+
+        //! \brief Getter for the result given to Signal().
+        [[nodiscard]] KsResult GetResult() const;
+
+    private:
+        friend class ComponentCoroutine;
+
+        void Signal(KsResult result, bool fromISR, BaseType_t* higherPriorityTaskWoken);
+
+    private:
+        std::atomic<bool> m_Signaled{ false };
+        //! Component whose coroutine awaits the completion
+        std::atomic<ComponentCoroutine*> m_Waiter{ nullptr };
+        KsResult m_Result = ks_success;
+    };
+
+    //! \enum KsCoroutineWait
+    //! \brief What the coroutine of a ComponentCoroutine is suspended on.
+    enum KsCoroutineWait : uint8_t {
+        //! Main() was created but hasn't run yet
+        ks_coroutine_wait_start,
+        //! The coroutine is running
+        ks_coroutine_wait_running,
+        //! Suspended in NextEvent()
+        ks_coroutine_wait_event,
+        //! Suspended in Sleep()
+        ks_coroutine_wait_timer,
+        //! Suspended in Await()
+        ks_coroutine_wait_completion,
+        //! Main() returned, events are released without being processed
+        ks_coroutine_wait_done
+    };
+
+    //! \class ComponentCoroutine
+    //! \brief A queued component whose logic is a coroutine awaiting events, timers and completions.
+    //!
+    //! The component doesn't own a task: like any queued component it is registered to a worker, and the worker
+    //! resumes its coroutine whenever what it awaits is ready. The coroutine frames come from a fixed pool, see
+    //! CoroutineTask, so dozens of components share the stack of a single worker. Every call to Main() or to an
+    //! awaited handler must fit in a frame of KS_COROUTINE_FRAME_SIZE bytes.
+    //!
+    //! The coroutine runs on the stack of the worker: it must not block, it awaits instead.
+    class ComponentCoroutine : public ComponentQueued {
+    private:
+        struct EventAwaiter {
+            ComponentCoroutine* component;
+
+            [[nodiscard]] bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<> handle) noexcept;
+            [[nodiscard]] const EventMessage& await_resume() const noexcept;
+        };
+
+        struct SleepAwaiter {
+            ComponentCoroutine* component;
+            KsTickType ticks;
+            KsResult result = ks_success;
+
+            [[nodiscard]] bool await_ready() const noexcept { return ticks == 0; }
+            void await_suspend(std::coroutine_handle<> handle) noexcept;
+            [[nodiscard]] KsResult await_resume() const noexcept { return result; }
+        };
+
+        struct CompletionAwaiter {
+            ComponentCoroutine* component;
+            Completion* completion;
+
+            [[nodiscard]] bool await_ready() const noexcept { return completion->IsSignaled(); }
+            void await_suspend(std::coroutine_handle<> handle) noexcept;
+            [[nodiscard]] KsResult await_resume() const noexcept { return completion->GetResult(); }
+        };
+
+    public:
+        //! \brief Creates a new coroutine component
+        //!
+        //! \param name the name of the component
+        explicit ComponentCoroutine(const String& name);
+
+        //! \brief Creates the coroutine and its timer, the coroutine starts on the next visit of the worker.
+        KsResult Init() override;
+
+        //! @copydoc
+        KsResult Destroy() override;
+
+        //! \brief Adds the control block of the timer to the memory of the queue.
+        [[nodiscard]] MemoryBudget GetMemoryBudget() const override;
+
+        //! \brief Resumes the coroutine while what it awaits is ready, within the budget of the visit.
+        KsResult ProcessEventQueue(size_t eventBudget, KsTickType timeBudget) override;
+        using ComponentQueued::ProcessEventQueue;
+
+        //! \brief Hands an event to the coroutine if it awaits one, drops it otherwise.
+        KsResult ProcessEvent(const EventMessage& message) final;
+
+        //! \brief Getter for what the coroutine is suspended on.
+        [[nodiscard]] KsCoroutineWait GetWait() const;
+
+        //! @copydoc
+        [[nodiscard]] bool HasWork() const override;
+
+    protected:
+        //! \brief The logic of the component, usually a loop awaiting events.
+        virtual CoroutineTask Main() = 0;
+
+        //! \brief Awaits the next event queued to the component.
+        //!
+        //! \return The event, only valid until the coroutine awaits again.
+        EventAwaiter NextEvent();
+
+        //! \brief Awaits a number of ticks while the worker runs other components.
+        //!
+        //! \return ks_error_coroutine_timer if the timer couldn't be started, in which case it returns right away.
+        SleepAwaiter Sleep(KsTickType ticks);
+
+        //! \brief Awaits the signal of a completion.
+        //!
+        //! \return The result given to Completion::Signal().
+        CompletionAwaiter Await(Completion& completion);
+
+    private:
+        friend class Completion;
+
+        //! \brief Checks whether the timer or completion awaited by the coroutine is ready.
+        [[nodiscard]] bool IsWaitOver() const;
+
+        //! \brief Resumes the coroutine where it is suspended.
+        void Resume();
+
+        static void TimerStub(TimerHandle_t timerHandle);
+
+    private:
+        CoroutineTask m_Main;
+        //! Innermost coroutine suspended, the one to resume
+        std::coroutine_handle<> m_Suspended{};
+        std::atomic<KsCoroutineWait> m_Wait{ ks_coroutine_wait_start };
+        //! Event handed to the coroutine by NextEvent()
+        const EventMessage* m_Event = nullptr;
+
+        TimerHandle_t m_Timer = nullptr;
+#if KS_STATIC_ALLOCATION
+        //! Control block of m_Timer
+        StaticTimer_t m_TimerControl{};
+#endif
+        std::atomic<bool> m_TimerFired{ false };
+        Completion* m_Completion = nullptr;
+    };
+
+}
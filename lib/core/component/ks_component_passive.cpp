@@ -1,4 +1,5 @@
 #include "ks_component_passive.h"
+#include "ks_framework.h"
 
 namespace kronos {
 
@@ -17,8 +18,13 @@ namespace kronos {
         return ks_success;
     }
 
-    KsResult ComponentPassive::ReceiveEvent(const EventMessage* message) {
-        KS_TRY(ks_error_component_receive_event, ProcessEvent(*message));
+    KsResult ComponentPassive::ReceiveEvent(const EventMessage* message, const Subscription& subscription) {
+        // Processed right away, a passive component never overflows
+        subscription.stats.delivered.fetch_add(1, std::memory_order_relaxed);
+
+        KsResult result = ProcessEvent(*message);
+        KS_TRY(ks_error_component_receive_event, Framework::ReleaseEventMessage(message));
+        KS_TRY(ks_error_component_receive_event, result);
 
         return ks_success;
     }
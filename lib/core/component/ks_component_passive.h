@@ -30,7 +30,7 @@ namespace kronos {
         KsResult Destroy() override;
 
         /// @copydoc
-        KsResult ReceiveEvent(const EventMessage* message) override;
+        KsResult ReceiveEvent(const EventMessage* message, const Subscription& subscription) override;
 
         //!
         KsResult ProcessEvent(const EventMessage& message) override;
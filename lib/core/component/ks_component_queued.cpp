@@ -1,34 +1,404 @@
 #include "ks_component_queued.h"
+#include "ks_component_worker.h"
 #include "ks_framework.h"
 
 namespace kronos {
 
-    ComponentQueued::ComponentQueued(const String& name, KsTickType queueTicksToWait)
-        : ComponentPassive(name), m_QueueTicksToWait(queueTicksToWait) {}
+    ComponentQueued::ComponentQueued(const String& name, KsTickType queueTicksToWait, size_t queueSize)
+        : ComponentPassive(name), m_QueueTicksToWait(queueTicksToWait) {
+        for (size_t lane = 0; lane < KS_EVENT_PRIORITY_LANES; lane++)
+            m_LaneSizes[lane] = std::max<size_t>(lane == ks_event_priority_high ? KS_QUEUE_HIGH_PRIORITY_SIZE : queueSize, 1);
+    }
 
     KsResult ComponentQueued::Init() {
-        m_Queue = Queue<const EventMessage*>::Create();
+        size_t pendingMax = 0;
+        for (size_t lane = 0; lane < KS_EVENT_PRIORITY_LANES; lane++) {
+#if KS_QUEUE_CALIBRATION
+            // Lanes are oversized while calibrating so that the peaks recorded aren't clipped by the current sizes
+            size_t length = KS_QUEUE_CALIBRATION_SIZE;
+#else
+            size_t length = m_LaneSizes[lane];
+#endif
+            m_Lanes[lane] = Queue<const EventMessage*>::Create(length);
+            if (m_Lanes[lane] == nullptr) KS_THROW(ks_error_static_arena_exhausted);
+            if (!m_Lanes[lane]->IsValid()) KS_THROW(ks_error_queue_create);
+            pendingMax += length;
+        }
+
+#if KS_STATIC_ALLOCATION
+        m_Pending = xSemaphoreCreateCountingStatic(pendingMax, 0, &m_PendingControl);
+#else
+        m_Pending = xSemaphoreCreateCounting(pendingMax, 0);
+#endif
+        if (m_Pending == nullptr) KS_THROW(ks_error_queue_create);
+
         return ComponentPassive::Init();
     }
 
+    MemoryBudget ComponentQueued::GetMemoryBudget() const {
+        MemoryBudget budget = ComponentPassive::GetMemoryBudget();
+        for (const auto& lane: m_Lanes) {
+            if (lane != nullptr) budget += lane->GetMemoryBudget();
+        }
+
+        budget.control += sizeof(StaticSemaphore_t);
+        return budget;
+    }
+
     KsResult ComponentQueued::Destroy() {
+        if (m_Pending != nullptr) vSemaphoreDelete(m_Pending);
+        m_Pending = nullptr;
+
         return ComponentPassive::Destroy();
     }
 
+    KsResult ComponentQueued::PopEvent(const EventMessage** message, KsTickType ticksToWait, uint32_t* missed) {
+        if (xSemaphoreTake(m_Pending, ticksToWait) != pdPASS) return ks_error_queue_pop;
+
+        // Every push is counted after it lands in its lane, so at least one lane holds an event
+        for (size_t lane = KS_EVENT_PRIORITY_LANES; lane-- > 0;) {
+            if (m_Lanes[lane]->TryPop(message) == ks_success) {
+                uint32_t merged = OnDequeue(*message, false);
+                if (missed != nullptr) *missed = merged;
+                return ks_success;
+            }
+        }
+
+        KS_THROW(ks_error_queue_pop);
+    }
+
+    size_t ComponentQueued::PopEvents(KsTickType ticksToWait, size_t maxEvents) {
+        maxEvents = std::min<size_t>(maxEvents, KS_EVENT_BATCH_SIZE);
+
+        m_BatchSize = 0;
+        while (m_BatchSize < maxEvents && PopEvent(
+            &m_Batch[m_BatchSize],
+            m_BatchSize == 0 ? ticksToWait : 0,
+            &m_BatchMissed[m_BatchSize]
+        ) == ks_success)
+            m_BatchSize++;
+
+        return m_BatchSize;
+    }
+
     KsResult ComponentQueued::ProcessEventQueue() {
-        const EventMessage* message;
-        while (m_Queue->Pop(&message, m_QueueTicksToWait) == ks_success) {
-            KS_TRY(ks_error_component_process_event, ProcessEvent(*message));
-            KS_TRY(ks_error_component_process_event, Framework::DeleteEventMessage(message));
+        return ProcessEventQueue(SIZE_MAX, portMAX_DELAY);
+    }
+
+    KsResult ComponentQueued::ProcessEventQueue(size_t eventBudget, KsTickType timeBudget) {
+        KsTickType start = xTaskGetTickCount();
+        KsTickType elapsed = 0;
+        size_t processed = 0;
+        KsResult result = ks_success;
+
+        while (processed < eventBudget && elapsed < timeBudget) {
+            size_t count = PopEvents(m_QueueTicksToWait, eventBudget - processed);
+            if (count == 0) break;
+
+            processed += count;
+            result = ProcessEventBatch();
+            elapsed = xTaskGetTickCount() - start;
+
+            if (result != ks_success) break;
+        }
+
+        RecordVisit(processed, elapsed, (processed >= eventBudget || elapsed >= timeBudget) && HasPendingEvents());
+
+        KS_TRY(ks_error_component_process_event, result);
+        return ks_success;
+    }
+
+    void ComponentQueued::RecordVisit(size_t processed, KsTickType elapsed, bool exhausted) {
+        m_VisitStats.visits.fetch_add(1, std::memory_order_relaxed);
+        m_VisitStats.events.fetch_add(processed, std::memory_order_relaxed);
+        m_VisitStats.busyTicks.fetch_add(elapsed, std::memory_order_relaxed);
+        // Only the task processing the queue updates the maxima, a plain load and store is enough
+        if (processed > m_VisitStats.maxEvents.load(std::memory_order_relaxed))
+            m_VisitStats.maxEvents.store(processed, std::memory_order_relaxed);
+        if (elapsed > m_VisitStats.maxTicks.load(std::memory_order_relaxed))
+            m_VisitStats.maxTicks.store(elapsed, std::memory_order_relaxed);
+        if (exhausted)
+            m_VisitStats.budgetExhausted.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    bool ComponentQueued::TryProcessEventQueue() {
+        if (m_Processing.test_and_set(std::memory_order_acquire)) return false;
+
+        ProcessEventQueue(m_EventBudget, m_TimeBudget);
+        m_Processing.clear(std::memory_order_release);
+
+        // Events left by the budget, or queued after the last pop while the worker skipped the component because
+        // it was still held here, bring the worker back once it has visited the other ready components
+        if (HasWork()) Wake();
+
+        return true;
+    }
+
+    bool ComponentQueued::HasWork() const {
+        return HasPendingEvents();
+    }
+
+    void ComponentQueued::Wake(bool fromISR, BaseType_t* higherPriorityTaskWoken) {
+        uintptr_t packed = m_Worker.load(std::memory_order_acquire);
+        auto* worker = reinterpret_cast<ComponentWorker*>(packed & ~ComponentWorker::s_SlotMask);
+        if (worker != nullptr)
+            worker->MarkReady(packed & ComponentWorker::s_SlotMask, fromISR, higherPriorityTaskWoken);
+    }
+
+    void ComponentQueued::SetBudget(size_t eventBudget, KsTickType timeBudget) {
+        m_EventBudget = std::max<size_t>(eventBudget, 1);
+        m_TimeBudget = std::max<KsTickType>(timeBudget, 1);
+    }
+
+    const VisitStats& ComponentQueued::GetVisitStats() const {
+        return m_VisitStats;
+    }
+
+    bool ComponentQueued::HasPendingEvents() const {
+        return m_Pending != nullptr && uxSemaphoreGetCount(m_Pending) > 0;
+    }
+
+    KsResult ComponentQueued::SetQueueSize(KsEventPriority priority, size_t size) {
+        if (m_Pending != nullptr) KS_THROW(ks_error_component_queue_created);
+
+        m_LaneSizes[std::min<size_t>(priority, KS_EVENT_PRIORITY_LANES - 1)] = std::max<size_t>(size, 1);
+        return ks_success;
+    }
+
+    size_t ComponentQueued::GetQueueSize(KsEventPriority priority) const {
+        size_t lane = std::min<size_t>(priority, KS_EVENT_PRIORITY_LANES - 1);
+        return m_Lanes[lane] != nullptr ? m_Lanes[lane]->Length() : m_LaneSizes[lane];
+    }
+
+    uint32_t ComponentQueued::GetHighWater(KsEventPriority priority) const {
+        return m_HighWater[std::min<size_t>(priority, KS_EVENT_PRIORITY_LANES - 1)].load(std::memory_order_relaxed);
+    }
+
+    void ComponentQueued::ResetHighWater() {
+        for (size_t lane = 0; lane < KS_EVENT_PRIORITY_LANES; lane++) {
+            uint32_t depth = m_Lanes[lane] != nullptr ? m_Lanes[lane]->Size() : 0;
+            m_HighWater[lane].store(depth, std::memory_order_relaxed);
+        }
+    }
+
+    KsResult ComponentQueued::ProcessEventBatch() {
+        std::span<const EventMessage* const> messages{ m_Batch, m_BatchSize };
+        KsResult result = ProcessEvents(messages);
+
+        bool released = true;
+        for (auto message: messages) {
+            if (Framework::ReleaseEventMessage(message) != ks_success)
+                released = false;
+        }
+        m_BatchSize = 0;
+
+        if (!released) KS_THROW(ks_error_component_process_event);
+        KS_TRY(ks_error_component_process_event, result);
+
+        return ks_success;
+    }
+
+    void ComponentQueued::SetWorker(ComponentWorker* worker, uint8_t slot) {
+        KS_ASSERT(slot <= ComponentWorker::s_SlotMask, "Slot is outside of the ready list of the worker")
+
+        // A single store, so that a wake never pairs the worker with the slot given by another one
+        m_Worker.store(reinterpret_cast<uintptr_t>(worker) | slot, std::memory_order_release);
+    }
+
+    uint32_t ComponentQueued::GetMissedEvents(const EventMessage& message) const {
+        for (size_t i = 0; i < m_BatchSize; i++) {
+            if (m_Batch[i] == &message) return m_BatchMissed[i];
+        }
+
+        return 0;
+    }
+
+    KsResult ComponentQueued::ProcessEvents(std::span<const EventMessage* const> messages) {
+        bool processed = true;
+        for (auto message: messages) {
+            if (ProcessEvent(*message) != ks_success)
+                processed = false;
         }
 
+        if (!processed) KS_THROW(ks_error_component_process_event);
+
         return ks_success;
     }
 
-    KsResult ComponentQueued::ReceiveEvent(const EventMessage* message) {
-        if (m_Queue->Push(message) != ks_success)
-            KS_TRY(ks_error_component_receive_event, Framework::DeleteEventMessage(message));
+    KsResult ComponentQueued::ReceiveEvent(const EventMessage* message, const Subscription& subscription) {
+        KsResult result = Enqueue(message, subscription, subscription.timeout, nullptr);
+
+        // Dropping is only an error when the publisher asked to wait for room
+        if (result == ks_error_component_event_dropped && subscription.overflow == ks_overflow_block)
+            KS_THROW(ks_error_component_receive_event);
+
+        return result;
+    }
+
+    KsResult ComponentQueued::ReceiveEvents(
+        std::span<const EventMessage* const> messages,
+        const Subscription& subscription
+    ) {
+        bool received = true;
+
+        // The events are only counted once the whole batch is queued, so that the consumer is woken once
+        uint32_t deferred = 0;
+        for (auto message: messages) {
+            if (Enqueue(message, subscription, subscription.timeout, nullptr, &deferred) != ks_success &&
+                subscription.overflow == ks_overflow_block)
+                received = false;
+        }
+        Signal(deferred);
+
+        if (!received) KS_THROW(ks_error_component_receive_event);
+
+        return ks_success;
+    }
+
+    KsResult ComponentQueued::ReceiveEventFromISR(
+        const EventMessage* message,
+        const Subscription& subscription,
+        BaseType_t* higherPriorityTaskWoken
+    ) {
+        return Enqueue(message, subscription, 0, higherPriorityTaskWoken);
+    }
+
+    KsResult ComponentQueued::Enqueue(
+        const EventMessage* message,
+        const Subscription& subscription,
+        KsTickType ticksToWait,
+        BaseType_t* higherPriorityTaskWoken,
+        uint32_t* deferred
+    ) {
+        bool fromISR = higherPriorityTaskWoken != nullptr;
+
+        // Only one event per code waits in the queue, later ones are merged into it until it is popped
+        CoalesceSlot* slot = nullptr;
+        if (subscription.overflow == ks_overflow_coalesce) {
+            slot = FindCoalesceSlot(message->eventCode);
+            const EventMessage* waiting = nullptr;
+            if (slot != nullptr &&
+                !slot->message.compare_exchange_strong(waiting, message, std::memory_order_acq_rel)) {
+                slot->missed.fetch_add(1, std::memory_order_relaxed);
+                subscription.stats.coalesced.fetch_add(1, std::memory_order_relaxed);
+                Framework::ReleaseEventMessage(message);
+                return ks_success;
+            }
+        }
+
+        size_t laneIndex = LaneOf(message);
+        auto& lane = *m_Lanes[laneIndex];
+        KsTickType wait = subscription.overflow == ks_overflow_block ? ticksToWait : 0;
+
+        bool queued = (fromISR ? lane.PushFromISR(message, higherPriorityTaskWoken)
+                               : lane.TryPush(message, deferred != nullptr ? 0 : wait)) == ks_success;
+
+        // The consumer can only pop the events of a batch once they are counted, which must happen before waiting
+        // for it to make room or evicting one of them
+        if (!queued && deferred != nullptr) {
+            Signal(std::exchange(*deferred, 0));
+            if (wait > 0) queued = lane.TryPush(message, wait) == ks_success;
+        }
+
+        // Evicting releases the oldest event, whose payload may free memory, so interrupts drop the new one instead
+        if (!queued && !fromISR && subscription.overflow == ks_overflow_drop_oldest && EvictOldest(lane)) {
+            subscription.stats.evicted.fetch_add(1, std::memory_order_relaxed);
+            queued = lane.TryPush(message) == ks_success;
+        }
+
+        if (!queued) {
+            if (slot != nullptr) slot->message.store(nullptr, std::memory_order_release);
+
+            subscription.stats.dropped.fetch_add(1, std::memory_order_relaxed);
+            Framework::ReleaseEventMessage(message);
+            return ks_error_component_event_dropped;
+        }
+
+        if (deferred != nullptr) {
+            (*deferred)++;
+        } else if (fromISR) {
+            xSemaphoreGiveFromISR(m_Pending, higherPriorityTaskWoken);
+        } else {
+            xSemaphoreGive(m_Pending);
+        }
+
+        // The depth is read after the push, so the mark includes the event that was just queued
+        auto depth = static_cast<uint32_t>(fromISR ? lane.SizeFromISR() : lane.Size());
+        auto& highWater = m_HighWater[laneIndex];
+        uint32_t peak = highWater.load(std::memory_order_relaxed);
+        while (depth > peak && !highWater.compare_exchange_weak(peak, depth, std::memory_order_relaxed)) {}
 
+        if (deferred == nullptr) Wake(fromISR, higherPriorityTaskWoken);
+
+        subscription.stats.delivered.fetch_add(1, std::memory_order_relaxed);
         return ks_success;
     }
+
+    void ComponentQueued::Signal(uint32_t count) {
+        if (count == 0) return;
+
+        // Giving never blocks, suspending the scheduler keeps the consumer from running before the last give
+        vTaskSuspendAll();
+        for (uint32_t i = 0; i < count; i++)
+            xSemaphoreGive(m_Pending);
+        xTaskResumeAll();
+
+        Wake();
+    }
+
+    bool ComponentQueued::EvictOldest(Queue<const EventMessage*>& lane) {
+        // Claim the count of the event first so the consumer never waits for an event that is gone
+        if (xSemaphoreTake(m_Pending, 0) != pdPASS) return false;
+
+        const EventMessage* oldest;
+        if (lane.TryPop(&oldest) != ks_success) {
+            xSemaphoreGive(m_Pending);
+            return false;
+        }
+
+        OnDequeue(oldest, true);
+        Framework::ReleaseEventMessage(oldest);
+        return true;
+    }
+
+    ComponentQueued::CoalesceSlot* ComponentQueued::FindCoalesceSlot(KsEventCodeType eventCode) {
+        for (auto& slot: m_CoalesceSlots) {
+            KsEventCodeType slotCode = slot.eventCode.load(std::memory_order_acquire);
+            if (slotCode == eventCode) return &slot;
+
+            if (slotCode == ks_event_invalid &&
+                slot.eventCode.compare_exchange_strong(slotCode, eventCode, std::memory_order_acq_rel))
+                return &slot;
+
+            // Another publisher may have just claimed this slot for the same code
+            if (slotCode == eventCode) return &slot;
+        }
+
+        return nullptr;
+    }
+
+    uint32_t ComponentQueued::OnDequeue(const EventMessage* message, bool evicted) {
+        for (auto& slot: m_CoalesceSlots) {
+            if (slot.eventCode.load(std::memory_order_acquire) != message->eventCode) continue;
+
+            // Only the coalesced event frees the slot, events of the same code queued through other subscriptions
+            // leave it waiting and later events keep being merged into it
+            const EventMessage* waiting = message;
+            if (!slot.message.compare_exchange_strong(waiting, nullptr, std::memory_order_acq_rel)) return 0;
+
+            // An evicted event is missed too, it is reported with the next one that gets processed
+            if (evicted) {
+                slot.missed.fetch_add(1, std::memory_order_relaxed);
+                return 0;
+            }
+
+            return slot.missed.exchange(0, std::memory_order_acq_rel);
+        }
+
+        return 0;
+    }
+
+    size_t ComponentQueued::LaneOf(const EventMessage* message) {
+        return std::min<size_t>(message->priority, KS_EVENT_PRIORITY_LANES - 1);
+    }
 }
@@ -9,35 +9,273 @@
 #include "ks_component_passive.h"
 
 namespace kronos {
+    class ComponentWorker;
+
+    //! \struct VisitStats
+    //! \brief Counters describing the visits paid to the queue of a component by the task processing it.
+    struct VisitStats {
+        //! Number of times the queue was processed
+        std::atomic<uint32_t> visits{ 0 };
+        //! Events processed over every visit
+        std::atomic<uint32_t> events{ 0 };
+        //! Ticks spent processing over every visit
+        std::atomic<uint32_t> busyTicks{ 0 };
+        //! Most events processed in a single visit
+        std::atomic<uint32_t> maxEvents{ 0 };
+        //! Most ticks spent in a single visit
+        std::atomic<uint32_t> maxTicks{ 0 };
+        //! Visits cut short by the budget while events were still waiting
+        std::atomic<uint32_t> budgetExhausted{ 0 };
+    };
+
+    //! \struct QueueProfileEntry
+    //! \brief High-water marks of the lanes of a component, as saved in a queue profile.
+    struct QueueProfileEntry {
+        //! HashID() of the name of the component
+        KsIdType id;
+        //! Most events that waited in every lane at the same time, indexed by priority
+        uint32_t highWater[KS_EVENT_PRIORITY_LANES];
+    };
 
     //! \class ComponentQueued
     //! \brief A class that implements the base for all queued components
     //!
-    //! This class is used as the base block for all queued components
+    //! This class is used as the base block for all queued components. Events are queued in one lane per
+    //! priority level and are always processed from the highest priority lane first, so that urgent events
+    //! overtake bulk traffic already waiting in the queue. When a lane is full, the overflow policy of the
+    //! subscription the event comes from decides whether the publisher waits, or which event is dropped.
     class ComponentQueued : public ComponentPassive {
 
     public:
         //! \brief Creates a new queued component
         //!
         //! \param name the name of the component
-        explicit ComponentQueued(const String& name, KsTickType queueTicksToWait = 0);
+        //! \param queueTicksToWait ticks to wait for an event when processing the queue
+        //! \param queueSize length of the low and normal priority lanes, the high priority lane holds
+        //! KS_QUEUE_HIGH_PRIORITY_SIZE events
+        explicit ComponentQueued(
+            const String& name,
+            KsTickType queueTicksToWait = 0,
+            size_t queueSize = KS_QUEUE_DEFAULT_SIZE
+        );
 
-        //! \brief Pops all events from the queue and processes them
+        //! \brief Pops all events from the queue, highest priority first, and processes them
         KsResult ProcessEventQueue();
 
+        //! \brief Pops events from the queue, highest priority first, and processes them until a budget runs out.
+        //!
+        //! \param eventBudget Most events processed, the last batch is shortened to fit.
+        //! \param timeBudget Ticks after which no new batch is started.
+        virtual KsResult ProcessEventQueue(size_t eventBudget, KsTickType timeBudget);
+
+        //! \brief Processes the queue within the budget of the component, unless another task is already processing it.
+        //!
+        //! Used by workers, which may briefly share a component while it migrates or is stolen. Events left in the
+        //! queue, either because the budget ran out or because they were queued while another task held the queue,
+        //! mark the component ready again so that its worker comes back to it after the other ready components.
+        //!
+        //! \return false if another task was processing the queue.
+        bool TryProcessEventQueue();
+
+        //! \brief Sets how much a worker processes from the queue on each visit, see TryProcessEventQueue().
+        //!
+        //! \param eventBudget Most events processed per visit, SIZE_MAX for no limit.
+        //! \param timeBudget Ticks after which a visit ends, portMAX_DELAY for no limit.
+        void SetBudget(size_t eventBudget, KsTickType timeBudget);
+
+        //! \brief Getter for the counters of the visits paid to the queue.
+        [[nodiscard]] const VisitStats& GetVisitStats() const;
+
+        //! \brief Checks whether events are waiting in the queue.
+        [[nodiscard]] bool HasPendingEvents() const;
+
+        //! \brief Sets the length of a lane, the lanes are created with the component so it must be called before Init().
+        //!
+        //! \param priority The priority of the lane.
+        //! \param size The number of events the lane holds, at least 1.
+        //! \return ks_error_component_queue_created if the lanes were already created.
+        KsResult SetQueueSize(KsEventPriority priority, size_t size);
+
+        //! \brief Getter for the length of a lane.
+        [[nodiscard]] size_t GetQueueSize(KsEventPriority priority) const;
+
+        //! \brief Getter for the most events that waited in a lane at the same time since the last reset.
+        [[nodiscard]] uint32_t GetHighWater(KsEventPriority priority) const;
+
+        //! \brief Restarts the high-water marks of every lane from the current depth of the lane.
+        void ResetHighWater();
+
+        //! \brief Checks whether a visit of the worker would have something to do.
+        //!
+        //! The default implementation checks for queued events. Components that also wait on other sources,
+        //! such as timers, override it.
+        [[nodiscard]] virtual bool HasWork() const;
+
         //! @copydoc
         KsResult Init() override;
 
         //! @copydoc
         KsResult Destroy() override;
 
+        //! \brief Reports the storage of the event lanes and the control blocks of the lanes and pending count.
+        [[nodiscard]] MemoryBudget GetMemoryBudget() const override;
+
         //! @copydoc
-        KsResult ReceiveEvent(const EventMessage* message) override;
+        KsResult ReceiveEvent(const EventMessage* message, const Subscription& subscription) override;
+
+        //! \brief Queues a whole batch of events and only wakes the consumer once they are all queued.
+        //!
+        //! Every overflow policy applies as it does to single events, ks_overflow_block waits up to the timeout of
+        //! the subscription for each event that doesn't fit.
+        KsResult ReceiveEvents(
+            std::span<const EventMessage* const> messages,
+            const Subscription& subscription
+        ) override;
+
+        //! \brief Queues an event published from an interrupt without blocking.
+        //!
+        //! ks_overflow_block and ks_overflow_drop_oldest behave like ks_overflow_drop_newest from an interrupt.
+        KsResult ReceiveEventFromISR(
+            const EventMessage* message,
+            const Subscription& subscription,
+            BaseType_t* higherPriorityTaskWoken
+        ) override;
+
+        //! \brief Processes a batch of events popped from the queue
+        //!
+        //! The default implementation calls ProcessEvent() for every event. Components that can handle several
+        //! events at once, for example by coalescing writes, override it. The messages are released by the caller.
+        //!
+        //! \param messages up to KS_EVENT_BATCH_SIZE events, highest priority first
+        virtual KsResult ProcessEvents(std::span<const EventMessage* const> messages);
+
+        //! \brief Sets the worker whose ready list the component joins every time an event is queued.
+        //!
+        //! \param worker The worker processing the queue of the component, nullptr if it has none.
+        //! \param slot The bit of the component in the ready list of the worker.
+        void SetWorker(ComponentWorker* worker, uint8_t slot);
+
+        //! \brief Gets the number of events that were merged into an event being processed
+        //!
+        //! Only events delivered through a ks_overflow_coalesce subscription are merged. A periodic handler can
+        //! use it to know how many ticks it missed while it was busy.
+        //!
+        //! \param message an event of the batch currently being processed
+        //! \return the number of events merged into it, 0 if none were
+        [[nodiscard]] uint32_t GetMissedEvents(const EventMessage& message) const;
 
     protected:
-        //! Queue that stores events being sent to the component.
-        Ref<Queue<const EventMessage*>> m_Queue;
+        //! \brief Pops the next event from the highest priority lane that has one.
+        //!
+        //! \param message Set to the event that was popped.
+        //! \param ticksToWait Ticks to wait for an event if every lane is empty.
+        //! \param missed Set to the number of events merged into the popped event, if not nullptr.
+        //! \return ks_success if an event was popped.
+        KsResult PopEvent(const EventMessage** message, KsTickType ticksToWait, uint32_t* missed = nullptr);
+
+        //! \brief Pops up to KS_EVENT_BATCH_SIZE events into the current batch, waiting only for the first one.
+        //!
+        //! \param ticksToWait Ticks to wait for the first event.
+        //! \param maxEvents Most events popped, capped to KS_EVENT_BATCH_SIZE.
+        //! \return The number of events that were popped.
+        size_t PopEvents(KsTickType ticksToWait, size_t maxEvents = KS_EVENT_BATCH_SIZE);
+
+        //! \brief Processes the current batch with ProcessEvents() and releases its events.
+        KsResult ProcessEventBatch();
+
+        //! \brief Marks the component ready on its worker without queuing an event.
+        //!
+        //! \param fromISR Whether the call is made from an interrupt.
+        //! \param higherPriorityTaskWoken Set when the worker should run on exit of the interrupt.
+        void Wake(bool fromISR = false, BaseType_t* higherPriorityTaskWoken = nullptr);
+
+        //! \brief Adds a visit to the counters returned by GetVisitStats().
+        //!
+        //! \param processed Number of events processed during the visit.
+        //! \param elapsed Ticks spent in the visit.
+        //! \param exhausted Whether the visit was cut short by its budget.
+        void RecordVisit(size_t processed, KsTickType elapsed, bool exhausted);
+
+    private:
+        //! \struct CoalesceSlot
+        //! \brief Tracks the event of a coalesced code waiting in the queue.
+        struct CoalesceSlot {
+            std::atomic<KsEventCodeType> eventCode{ ks_event_invalid };
+            //! The coalesced event waiting in the queue, events of the same code are merged into it until it leaves
+            std::atomic<const EventMessage*> message{ nullptr };
+            //! Events merged since the last one of this code was popped
+            std::atomic<uint32_t> missed{ 0 };
+        };
+
+        //! \brief Gets the lane an event is queued in.
+        static size_t LaneOf(const EventMessage* message);
+
+        //! \brief Queues an event according to the overflow policy of its subscription.
+        //!
+        //! \param message The event to queue, it is released if it is dropped or coalesced.
+        //! \param subscription The subscription the event is delivered through.
+        //! \param ticksToWait Ticks to wait for room in the lane, only used by ks_overflow_block.
+        //! \param higherPriorityTaskWoken nullptr from a task, the woken flag of the interrupt otherwise.
+        //! \param deferred nullptr to count the event and wake the consumer right away, otherwise the number of
+        //! queued events not counted yet, which is increased instead. See Signal().
+        KsResult Enqueue(
+            const EventMessage* message,
+            const Subscription& subscription,
+            KsTickType ticksToWait,
+            BaseType_t* higherPriorityTaskWoken,
+            uint32_t* deferred = nullptr
+        );
+
+        //! \brief Counts events queued by a batch and wakes the consumer once for all of them.
+        void Signal(uint32_t count);
+
+        //! \brief Drops the oldest event of a lane to make room for a new one, never called from an interrupt.
+        bool EvictOldest(Queue<const EventMessage*>& lane);
+
+        //! \brief Finds the coalescing slot of an event code, claiming a free one if needed.
+        //!
+        //! \return nullptr if every slot is used by another code, in which case the event is not coalesced.
+        CoalesceSlot* FindCoalesceSlot(KsEventCodeType eventCode);
+
+        //! \brief Called for every event leaving the queue, whether it is popped or evicted.
+        //!
+        //! \param message The event leaving the queue.
+        //! \param evicted Whether the event was dropped instead of popped.
+        //! \return The number of events merged into a popped event.
+        uint32_t OnDequeue(const EventMessage* message, bool evicted);
+
+    protected:
+        //! Queues that store events being sent to the component, indexed by priority.
+        Ref<Queue<const EventMessage*>> m_Lanes[KS_EVENT_PRIORITY_LANES];
+        //! Length of every lane, used when the lanes are created
+        size_t m_LaneSizes[KS_EVENT_PRIORITY_LANES];
+        //! Most events that waited in every lane at the same time
+        std::atomic<uint32_t> m_HighWater[KS_EVENT_PRIORITY_LANES]{};
+        //! Counts the events waiting across every lane, consumers block on it instead of a single lane.
+        SemaphoreHandle_t m_Pending = nullptr;
+#if KS_STATIC_ALLOCATION
+        //! Control block of m_Pending
+        StaticSemaphore_t m_PendingControl{};
+#endif
+        //! Event codes delivered through coalescing subscriptions
+        CoalesceSlot m_CoalesceSlots[KS_COALESCE_SLOTS];
+
+        //! Events popped from the queue and being processed
+        const EventMessage* m_Batch[KS_EVENT_BATCH_SIZE]{};
+        //! Number of events merged into each event of the batch
+        uint32_t m_BatchMissed[KS_EVENT_BATCH_SIZE]{};
+        size_t m_BatchSize{ 0 };
         KsTickType m_QueueTicksToWait;
+        //! Most events processed per visit of a worker
+        size_t m_EventBudget = KS_QUEUE_EVENT_BUDGET;
+        //! Ticks after which a visit of a worker ends
+        KsTickType m_TimeBudget = KS_QUEUE_TIME_BUDGET;
+        VisitStats m_VisitStats;
+        //! Set while a task is processing the queue, see TryProcessEventQueue()
+        std::atomic_flag m_Processing = ATOMIC_FLAG_INIT;
+        //! Worker marked ready when an event is queued, with the bit of the component in its ready list packed in
+        //! the low bits of the address so that both always change together, see SetWorker()
+        std::atomic<uintptr_t> m_Worker{ 0 };
     };
 
 }
\ No newline at end of file
@@ -6,31 +6,268 @@ namespace kronos {
         const std::string& name,
         size_t stackSize,
         uint16_t priority
-    ) : ComponentActive(name, 0, stackSize, priority) {}
+    ) : ComponentActive(name, 0, stackSize, priority) {
+        SetWorker(this, 0);
+    }
 
     void ComponentWorker::Run() {
+        // Events queued before the task started didn't wake anyone, every queue gets a first pass
+        KsTickType now = xTaskGetTickCount();
+        for (auto& readySince: m_ReadySince)
+            readySince.store(now, std::memory_order_relaxed);
+        m_Ready.fetch_or(UINT32_MAX, std::memory_order_relaxed);
+
         while (true) {
+            KsTickType start = BeginWork();
             { // SCOPE FOR PROFILER
-                const EventMessage* message;
-                if (m_Queue->Pop(&message, 0) != ks_success) {
-                    ComponentActive::ProcessEvent(*message);
-                    Framework::DeleteEventMessage(message);
-
-                    // if(res.HasError()) StackTrace::Flush(), use the framework housekeeping
-                }
+                ProcessReady(m_Ready.exchange(0, std::memory_order_acquire));
 
-                for (const auto& component: m_QueuedComponents)
-                    component->ProcessEventQueue();
+#if KS_WORKER_STEALING
+                // Helps the rest of the pool as long as nothing of its own is ready
+                while (m_Ready.load(std::memory_order_relaxed) == 0 && Steal()) {}
+#endif
 
                 // if(res.HasError()) StackTrace::Flush(), use the framework housekeeping
             }
+            EndWork(start);
+
+            // Sleeps until a component is marked ready or the period is due
+            m_Idle.store(true, std::memory_order_relaxed);
+            ulTaskNotifyTake(pdTRUE, GetTicksToWait());
+            m_Idle.store(false, std::memory_order_relaxed);
+        }
+    }
+
+    KsResult ComponentWorker::ProcessPeriodic() {
+        if (!m_Pool.empty() && m_Pool.front() == this)
+            KS_TRY(ks_error_component_run, Balance());
+
+        return ComponentActive::ProcessPeriodic();
+    }
+
+    void ComponentWorker::ProcessReady(uint32_t ready) {
+        while (ready != 0) {
+            auto slot = static_cast<uint8_t>(std::countr_zero(ready));
+            ready &= ready - 1;
+
+            ProcessSlot(slot);
+        }
+    }
+
+    void ComponentWorker::ProcessSlot(uint8_t slot) {
+        if (slot == 0) {
+            TryProcessEventQueue();
+            return;
+        }
+
+        HostedComponent hosted;
+        if (!GetHosted(slot, &hosted)) return;
+
+        KsTickType waited = xTaskGetTickCount() - m_ReadySince[slot].load(std::memory_order_relaxed);
+        hosted.component->TryProcessEventQueue();
+
+        taskENTER_CRITICAL();
+        // The table may have changed while the queue was processed
+        HostedComponent& entry = m_Hosted[slot - 1];
+        if (slot <= m_HostedCount && entry.component == hosted.component)
+            entry.latency = entry.latency - entry.latency / 8 + waited;
+        taskEXIT_CRITICAL();
+    }
+
+    bool ComponentWorker::Steal() {
+        for (ComponentWorker* sibling: m_Pool) {
+            if (sibling == this) continue;
+
+            // The queue of the worker itself, bit 0, is never taken from it
+            uint32_t ready = sibling->m_Ready.load(std::memory_order_relaxed) & ~1u;
+            while (ready != 0) {
+                auto slot = static_cast<uint8_t>(std::countr_zero(ready));
+                ready &= ready - 1;
+
+                // Clearing the bit claims the component, its worker won't process it for this event
+                uint32_t bit = 1u << slot;
+                if ((sibling->m_Ready.fetch_and(~bit, std::memory_order_acquire) & bit) == 0) continue;
+
+                sibling->ProcessSlot(slot);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void ComponentWorker::MarkReady(uint8_t slot, bool fromISR, BaseType_t* higherPriorityTaskWoken) {
+        uint32_t bit = 1u << slot;
+
+        if ((m_Ready.load(std::memory_order_relaxed) & bit) == 0) {
+            m_ReadySince[slot].store(
+                fromISR ? xTaskGetTickCountFromISR() : xTaskGetTickCount(),
+                std::memory_order_relaxed
+            );
+        }
+
+        // Only the first event of a component wakes the worker, the following ones are drained on the same pass
+        if ((m_Ready.fetch_or(bit, std::memory_order_release) & bit) != 0) return;
+
+        auto wake = [&](TaskHandle_t task) {
+            if (task == nullptr) return;
+
+            if (fromISR) {
+                vTaskNotifyGiveFromISR(task, higherPriorityTaskWoken);
+            } else {
+                xTaskNotifyGive(task);
+            }
+        };
+
+        wake(m_Task);
+
+#if KS_WORKER_STEALING
+        // A busy worker gets help from an idle one of its pool
+        if (!m_Idle.load(std::memory_order_relaxed)) {
+            for (ComponentWorker* sibling: m_Pool) {
+                if (sibling != this && sibling->m_Idle.load(std::memory_order_relaxed)) {
+                    wake(sibling->m_Task);
+                    break;
+                }
+            }
+        }
+#endif
+    }
 
-            taskYIELD();
+    KsResult ComponentWorker::RegisterComponent(ComponentQueued* component, uint16_t priority) {
+        bool full = false;
+
+        taskENTER_CRITICAL();
+        if (m_HostedCount < s_MaxComponents) {
+            // Kept sorted by decreasing priority, components of equal priority in registration order
+            size_t position = 0;
+            while (position < m_HostedCount && m_Hosted[position].priority >= priority)
+                position++;
+
+            std::move_backward(m_Hosted + position, m_Hosted + m_HostedCount, m_Hosted + m_HostedCount + 1);
+            m_Hosted[position] = { component, priority };
+            m_HostedCount++;
+        } else {
+            full = true;
         }
+        taskEXIT_CRITICAL();
+
+        if (full) KS_THROW(ks_error_component_worker_full);
+
+        AssignSlots();
+        return ks_success;
     }
 
-    KsResult ComponentWorker::RegisterComponent(ComponentQueued* component) {
-        m_QueuedComponents.push_back(component);
+    KsResult ComponentWorker::RemoveComponent(ComponentQueued* component) {
+        bool found = false;
+
+        taskENTER_CRITICAL();
+        auto end = m_Hosted + m_HostedCount;
+        auto position = std::find_if(m_Hosted, end, [&](const auto& hosted) { return hosted.component == component; });
+        if (position != end) {
+            std::move(position + 1, end, position);
+            m_HostedCount--;
+            m_Hosted[m_HostedCount] = {};
+            component->SetWorker(nullptr, 0);
+            found = true;
+        }
+        taskEXIT_CRITICAL();
+
+        if (!found) KS_THROW(ks_error_component_worker_missing);
+
+        AssignSlots();
         return ks_success;
     }
+
+    void ComponentWorker::AssignSlots() {
+        taskENTER_CRITICAL();
+        for (size_t i = 0; i < m_HostedCount; i++)
+            m_Hosted[i].component->SetWorker(this, i + 1);
+        taskEXIT_CRITICAL();
+
+        KsTickType now = xTaskGetTickCount();
+        for (auto& readySince: m_ReadySince)
+            readySince.store(now, std::memory_order_relaxed);
+
+        // Slots moved, a ready bit may now point at another component so every queue gets a pass
+        m_Ready.fetch_or(UINT32_MAX, std::memory_order_release);
+        if (m_Task != nullptr) xTaskNotifyGive(m_Task);
+    }
+
+    bool ComponentWorker::GetHosted(uint8_t slot, HostedComponent* hosted) const {
+        bool found = false;
+
+        taskENTER_CRITICAL();
+        if (slot > 0 && slot <= m_HostedCount) {
+            *hosted = m_Hosted[slot - 1];
+            found = true;
+        }
+        taskEXIT_CRITICAL();
+
+        return found;
+    }
+
+    void ComponentWorker::SetPool(std::span<ComponentWorker* const> pool) {
+        m_Pool = pool;
+
+        if (pool.size() > 1 && pool.front() == this)
+            SetPeriod(KS_WORKER_BALANCE_PERIOD);
+    }
+
+    KsResult ComponentWorker::Balance() {
+        if (m_Pool.size() < 2) return ks_success;
+
+        ComponentWorker* busiest = nullptr;
+        ComponentWorker* idlest = nullptr;
+        uint32_t busiestLoad = 0;
+        uint32_t idlestLoad = UINT32_MAX;
+        for (ComponentWorker* worker: m_Pool) {
+            uint32_t load = worker->GetLoad();
+            if (busiest == nullptr || load > busiestLoad) {
+                busiest = worker;
+                busiestLoad = load;
+            }
+            if (worker->GetComponentCount() < s_MaxComponents && load < idlestLoad) {
+                idlest = worker;
+                idlestLoad = load;
+            }
+        }
+
+        if (idlest == nullptr || idlest == busiest) return ks_success;
+
+        // The component that waits the longest is the one that gains the most from moving
+        HostedComponent candidate;
+        taskENTER_CRITICAL();
+        for (size_t i = 0; i < busiest->m_HostedCount; i++) {
+            if (busiest->m_Hosted[i].latency >= candidate.latency)
+                candidate = busiest->m_Hosted[i];
+        }
+        taskEXIT_CRITICAL();
+
+        uint32_t latency = candidate.latency / 8;
+        if (candidate.component == nullptr || latency < KS_WORKER_MIGRATION_LATENCY) return ks_success;
+
+        // Moving must not make the other worker busier than the busiest one was, or the component would bounce back
+        if (idlestLoad + latency >= busiestLoad) return ks_success;
+
+        KS_TRY(ks_error_component_run, busiest->RemoveComponent(candidate.component));
+        KS_TRY(ks_error_component_run, idlest->RegisterComponent(candidate.component, candidate.priority));
+
+        return ks_success;
+    }
+
+    uint32_t ComponentWorker::GetLoad() const {
+        uint32_t load = 0;
+
+        taskENTER_CRITICAL();
+        for (size_t i = 0; i < m_HostedCount; i++)
+            load += m_Hosted[i].latency / 8;
+        taskEXIT_CRITICAL();
+
+        return load;
+    }
+
+    size_t ComponentWorker::GetComponentCount() const {
+        return m_HostedCount;
+    }
 }
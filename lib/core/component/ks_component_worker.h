@@ -3,9 +3,31 @@
 #include "ks_bus.h"
 #include "ks_component_active.h"
 
+// Idle workers take ready components from the other workers of their pool. It only pays off when workers can
+// run at the same time, so it defaults to SMP builds but can be forced on, for example on the host port.
+#ifndef KS_WORKER_STEALING
+#if defined(configNUMBER_OF_CORES) && configNUMBER_OF_CORES > 1
+#define KS_WORKER_STEALING 1
+#else
+#define KS_WORKER_STEALING 0
+#endif
+#endif
+
 namespace kronos {
 
-    class ComponentWorker : public ComponentActive {
+    //! \class ComponentWorker
+    //! \brief An active component whose task also processes the queues of the components registered to it.
+    //!
+    //! Queuing an event to a hosted component sets its bit in the ready list of the worker and wakes the worker's
+    //! task. The task then only processes the queues on its ready list, highest priority first, and sleeps when
+    //! the list is empty. The queue of the worker itself holds the first bit so it is always serviced first.
+    //!
+    //! Workers can be grouped in a pool with SetPool(). The worker measures how long each hosted component waits
+    //! between being marked ready and being serviced, and Balance() moves the component that waits the longest
+    //! to the least loaded worker of the pool.
+    //!
+    //! Workers are aligned so that ComponentQueued can keep its slot in the low bits of the address of its worker.
+    class alignas(32) ComponentWorker : public ComponentActive {
 
     public:
         explicit ComponentWorker(
@@ -15,12 +37,100 @@ namespace kronos {
         );
 
         [[noreturn]] void Run() override;
-        KsResult RegisterComponent(ComponentQueued* component);
+
+        //! \brief Balances the pool when the worker leads it, see SetPool().
+        KsResult ProcessPeriodic() override;
+
+        //! \brief Hosts a queued component on the worker.
+        //!
+        //! \param component The component whose queue the worker processes.
+        //! \param priority Components with a higher priority are serviced first when several are ready.
+        //! \return ks_error_component_worker_full if the ready list has no bit left.
+        KsResult RegisterComponent(ComponentQueued* component, uint16_t priority = KS_COMPONENT_PRIORITY_MEDIUM);
+
+        //! \brief Stops hosting a queued component.
+        //!
+        //! \return ks_error_component_worker_missing if the component isn't hosted by the worker.
+        KsResult RemoveComponent(ComponentQueued* component);
+
+        //! \brief Marks a hosted component as ready and wakes the worker if it wasn't already.
+        //!
+        //! \param slot The bit of the component in the ready list, given by ComponentQueued::SetWorker().
+        //! \param fromISR Whether the call is made from an interrupt.
+        //! \param higherPriorityTaskWoken Set when the worker should run on exit of the interrupt.
+        void MarkReady(uint8_t slot, bool fromISR = false, BaseType_t* higherPriorityTaskWoken = nullptr);
+
+        //! \brief Sets the workers sharing load with this one.
+        //!
+        //! The first worker of the pool leads it: it calls Balance() every KS_WORKER_BALANCE_PERIOD ticks.
+        //!
+        //! \param pool Every worker of the pool, including this one. It must outlive the worker.
+        void SetPool(std::span<ComponentWorker* const> pool);
+
+        //! \brief Moves at most one component from the most to the least loaded worker of the pool.
+        //!
+        //! A component only moves when its latency is above KS_WORKER_MIGRATION_LATENCY and the move lowers
+        //! the load of the busiest worker without making the other one busier than it was.
+        //!
+        //! \return ks_success whether or not a component moved.
+        KsResult Balance();
+
+        //! \brief Getter for the load of the worker, the sum of the latencies of its components.
+        [[nodiscard]] uint32_t GetLoad() const;
+
+        //! \brief Getter for the number of components hosted by the worker.
+        [[nodiscard]] size_t GetComponentCount() const;
+
+        //! Maximum number of components hosted by a worker, one bit of the ready list is taken by the worker itself
+        static constexpr size_t s_MaxComponents = 31;
+        //! Bits of the address of a worker that hold a slot of its ready list, see ComponentQueued::SetWorker()
+        static constexpr uintptr_t s_SlotMask = s_MaxComponents;
 
     protected:
-        List<ComponentQueued*> m_QueuedComponents{};
+        //! A component hosted by the worker
+        struct HostedComponent {
+            ComponentQueued* component = nullptr;
+            uint16_t priority = 0;
+            //! Ticks between the component being marked ready and being serviced, averaged over about 8 passes
+            //! and scaled by 8 so that short waits don't round down to nothing
+            uint32_t latency = 0;
+        };
+
+        //! \brief Processes the queue of every component on a ready list, lowest bit first.
+        void ProcessReady(uint32_t ready);
+
+        //! \brief Processes one ready component and updates its latency.
+        void ProcessSlot(uint8_t slot);
+
+        //! \brief Processes a component taken from the ready list of another worker of the pool.
+        //!
+        //! \return true if a component was taken.
+        bool Steal();
+
+        //! \brief Copies the component in a slot of the ready list.
+        //!
+        //! \return false if no component owns the slot.
+        bool GetHosted(uint8_t slot, HostedComponent* hosted) const;
+
+        //! \brief Gives every hosted component its slot again after the table changed.
+        void AssignSlots();
+
+        //! Hosted components by decreasing priority, the component at index i owns bit i + 1 of the ready list
+        HostedComponent m_Hosted[s_MaxComponents]{};
+        size_t m_HostedCount = 0;
+        //! One bit per component with queued events
+        std::atomic<uint32_t> m_Ready{ 0 };
+        //! Tick at which each bit of the ready list was last set
+        std::atomic<KsTickType> m_ReadySince[s_MaxComponents + 1]{};
+        //! Set while the task sleeps waiting for work
+        std::atomic<bool> m_Idle{ false };
+        //! Workers sharing load with this one, including itself
+        std::span<ComponentWorker* const> m_Pool{};
         EventMessage m_EventMessage;
 
     };
 
+    static_assert(alignof(ComponentWorker) > ComponentWorker::s_SlotMask,
+                  "Workers must be aligned enough to hold a slot in the low bits of their address!");
+
 }
@@ -0,0 +1,111 @@
+#include "ks_boot.h"
+#include "ks_file.h"
+
+namespace kronos {
+
+    void BootTimeline::Record(const BootRecord& record) {
+        size_t index = m_Count.fetch_add(1, std::memory_order_relaxed);
+        if (index < KS_BOOT_TIMELINE_SIZE) m_Records[index] = record;
+    }
+
+    std::span<const BootRecord> BootTimeline::GetRecords() const {
+        return { m_Records, std::min<size_t>(m_Count.load(std::memory_order_relaxed), KS_BOOT_TIMELINE_SIZE) };
+    }
+
+    size_t BootTimeline::GetDropped() const {
+        size_t count = m_Count.load(std::memory_order_relaxed);
+        return count > KS_BOOT_TIMELINE_SIZE ? count - KS_BOOT_TIMELINE_SIZE : 0;
+    }
+
+    KsResult BootTimeline::Save(const String& path) const {
+        File file(path, KS_OPEN_MODE_WRITE_ONLY | KS_OPEN_MODE_CREATE | KS_OPEN_MODE_TRUNCATE);
+        if (!file.IsOpen()) KS_THROW(ks_error_file_open);
+
+        auto records = GetRecords();
+        uint32_t header[] = { static_cast<uint32_t>(records.size()), static_cast<uint32_t>(GetDropped()) };
+
+        if (file.Write(header, sizeof(header)) < 0) KS_THROW(ks_error_file_write);
+        if (file.Write(records.data(), records.size_bytes()) < 0) KS_THROW(ks_error_file_write);
+
+        return file.Sync();
+    }
+
+    BootPool::BootPool(size_t tasks) {
+#if KS_STATIC_ALLOCATION
+        tasks = 0;
+#endif
+        if (tasks == 0) return;
+
+        m_Start = xSemaphoreCreateCounting(tasks, 0);
+        m_Done = xSemaphoreCreateCounting(tasks, 0);
+        if (m_Start == nullptr || m_Done == nullptr) return;
+
+        UBaseType_t priority = uxTaskPriorityGet(nullptr);
+        while (m_TaskCount < tasks) {
+            if (xTaskCreate(Start, "BOOT", KS_BOOT_TASK_STACK_SIZE, this, priority, nullptr) != pdPASS) break;
+            m_TaskCount++;
+        }
+    }
+
+    BootPool::~BootPool() {
+        // Wakes every task up without steps, which makes them exit
+        m_Step = nullptr;
+        for (size_t i = 0; i < m_TaskCount; i++) xSemaphoreGive(m_Start);
+        for (size_t i = 0; i < m_TaskCount; i++) xSemaphoreTake(m_Done, portMAX_DELAY);
+
+        if (m_Start != nullptr) vSemaphoreDelete(m_Start);
+        if (m_Done != nullptr) vSemaphoreDelete(m_Done);
+    }
+
+    KsResult BootPool::Run(size_t count, Step step, void* context) {
+        m_Step = step;
+        m_Context = context;
+        m_Count = count;
+        m_Next.store(0, std::memory_order_relaxed);
+        m_Result.store(ks_success, std::memory_order_relaxed);
+
+        // The calling task runs steps too, so one step less than the tasks is enough to keep them all busy
+        size_t helpers = count > 1 ? std::min(m_TaskCount, count - 1) : 0;
+        for (size_t i = 0; i < helpers; i++) xSemaphoreGive(m_Start);
+
+        Work(0);
+
+        for (size_t i = 0; i < helpers; i++) xSemaphoreTake(m_Done, portMAX_DELAY);
+
+        return m_Result.load(std::memory_order_relaxed);
+    }
+
+    size_t BootPool::GetTaskCount() const {
+        return m_TaskCount;
+    }
+
+    void BootPool::Work(uint8_t task) {
+        while (m_Result.load(std::memory_order_relaxed) == ks_success) {
+            size_t index = m_Next.fetch_add(1, std::memory_order_relaxed);
+            if (index >= m_Count) break;
+
+            KsResult result = m_Step(m_Context, index, task);
+            if (result != ks_success) {
+                KsResult expected = ks_success;
+                m_Result.compare_exchange_strong(expected, result, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void BootPool::Start(void* data) {
+        auto* pool = static_cast<BootPool*>(data);
+        uint8_t task = pool->m_TaskIds.fetch_add(1, std::memory_order_relaxed) + 1;
+
+        while (true) {
+            xSemaphoreTake(pool->m_Start, portMAX_DELAY);
+            if (pool->m_Step == nullptr) break;
+
+            pool->Work(task);
+            xSemaphoreGive(pool->m_Done);
+        }
+
+        xSemaphoreGive(pool->m_Done);
+        vTaskDelete(nullptr);
+    }
+
+}
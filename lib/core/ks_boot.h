@@ -0,0 +1,155 @@
+#pragma once
+
+namespace kronos {
+
+    //! Kind of step recorded in the boot timeline
+    enum KsBootStep : uint8_t {
+        //! Construction of an IO descriptor, see Framework::CreateDescriptor()
+        ks_boot_step_driver,
+        //! IModule::Init() of a module
+        ks_boot_step_module,
+        //! ComponentBase::Init() of a component
+        ks_boot_step_component_init,
+        //! ComponentBase::PostInit() of a component
+        ks_boot_step_component_post_init,
+    };
+
+    //! \struct BootRecord
+    //! \brief A timed step of the boot, written as is to the boot timeline file.
+    struct BootRecord {
+        //! HashID() of the name of the driver, module or component
+        KsIdType id;
+        //! Tick at which the step started
+        KsTickType start;
+        //! Ticks the step took
+        KsTickType duration;
+        KsResult result;
+        KsBootStep step;
+        //! Dependency level the step belongs to
+        uint8_t level;
+        //! Task that ran the step, 0 for the task starting the framework and 1 onwards for the boot tasks
+        uint8_t task;
+    };
+
+    //! \class BootTimeline
+    //! \brief Record of every driver, module and component step of the boot and how long it took.
+    //!
+    //! Steps can be recorded from several tasks at the same time. The timeline holds KS_BOOT_TIMELINE_SIZE
+    //! records, later steps are only counted. Durations have the resolution of the tick.
+    class BootTimeline {
+    public:
+        //! \brief Runs a step and records how long it took.
+        //!
+        //! \param step The kind of step.
+        //! \param id The HashID() of the name of the driver, module or component.
+        //! \param level The dependency level the step belongs to.
+        //! \param task The task running the step.
+        //! \param f The step, returning a KsResult.
+        //! \return The result of the step.
+        template<typename F>
+        KsResult Time(KsBootStep step, KsIdType id, uint8_t level, uint8_t task, F&& f) {
+            KsTickType start = xTaskGetTickCount();
+            KsResult result = f();
+
+            Record({
+                .id = id,
+                .start = start,
+                .duration = xTaskGetTickCount() - start,
+                .result = result,
+                .step = step,
+                .level = level,
+                .task = task
+            });
+
+            return result;
+        }
+
+        //! \brief Adds a step to the timeline, or counts it as dropped if the timeline is full.
+        void Record(const BootRecord& record);
+
+        //! \brief Getter for the recorded steps, in the order they finished.
+        [[nodiscard]] std::span<const BootRecord> GetRecords() const;
+
+        //! \brief Getter for the number of steps that did not fit in the timeline.
+        [[nodiscard]] size_t GetDropped() const;
+
+        //! \brief Writes the timeline to a file so that it can be downlinked.
+        //!
+        //! The file holds the number of records and of dropped steps, both as uint32_t, followed by the records.
+        //!
+        //! \param path The path of the file, it is overwritten.
+        KsResult Save(const String& path) const;
+
+    private:
+        BootRecord m_Records[KS_BOOT_TIMELINE_SIZE]{};
+        std::atomic<size_t> m_Count{ 0 };
+    };
+
+    //! \class BootPool
+    //! \brief Tasks helping the task starting the framework to run the steps of a dependency level in parallel.
+    //!
+    //! The tasks are created with the priority of the task creating the pool and deleted with the pool. A pool
+    //! without tasks, or one that could not create them, runs every step on the calling task. In static allocation
+    //! mode the pool never creates tasks, as their stacks could not be given back once the boot is over.
+    class BootPool {
+    public:
+        //! \brief Function running a step.
+        //!
+        //! \param context The context given to Run().
+        //! \param index The index of the step, from 0 to the number of steps.
+        //! \param task The task running the step, 0 for the calling task.
+        using Step = KsResult (*)(void* context, size_t index, uint8_t task);
+
+        //! \brief Creates the pool and its tasks.
+        //!
+        //! \param tasks The number of tasks helping the calling task.
+        explicit BootPool(size_t tasks = KS_BOOT_TASKS);
+
+        //! \brief Stops and deletes the tasks of the pool.
+        ~BootPool();
+
+        BootPool(const BootPool& other) = delete;
+        void operator=(const BootPool& other) = delete;
+
+        //! \brief Runs count steps across the calling task and the tasks of the pool, and waits for all of them.
+        //!
+        //! Once a step fails, the steps that did not start yet are skipped.
+        //!
+        //! \return The result of the first step that failed, ks_success if none did.
+        KsResult Run(size_t count, Step step, void* context);
+
+        //! \brief Runs count steps given as a callable taking the index of the step and the task running it.
+        template<typename F>
+        KsResult Run(size_t count, F&& step) {
+            return Run(count, [](void* context, size_t index, uint8_t task) {
+                return (*static_cast<std::remove_reference_t<F>*>(context))(index, task);
+            }, &step);
+        }
+
+        //! \brief Getter for the number of tasks helping the calling task.
+        [[nodiscard]] size_t GetTaskCount() const;
+
+    private:
+        //! \brief Runs steps until none is left or one failed.
+        void Work(uint8_t task);
+
+        //! \brief Entry point of the tasks of the pool.
+        static void Start(void* data);
+
+    private:
+        //! Given once per task to start running steps
+        SemaphoreHandle_t m_Start = nullptr;
+        //! Given once per task when it ran out of steps
+        SemaphoreHandle_t m_Done = nullptr;
+        size_t m_TaskCount = 0;
+        std::atomic<uint8_t> m_TaskIds{ 0 };
+
+        //! Steps being run, nullptr to stop the tasks
+        Step m_Step = nullptr;
+        void* m_Context = nullptr;
+        size_t m_Count = 0;
+        std::atomic<size_t> m_Next{ 0 };
+        std::atomic<KsResult> m_Result{ ks_success };
+    };
+
+}
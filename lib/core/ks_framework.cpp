@@ -1,29 +1,182 @@
 #include "ks_framework.h"
+#include "ks_bus.h"
+#include "ks_filesystem.h"
+#include "ks_file.h"
 
 namespace kronos {
 
     KS_SINGLETON_INSTANCE(Framework);
 
+    Pool<EventMessage, KS_EVENT_MESSAGE_POOL_SIZE> Framework::s_EventMessagePool;
+
     KsResult Framework::_Start() {
-        // Init Components
-        for (auto& component: m_Components) {
-            KS_TRY(ks_error_component_initialize, component.second->Init());
+        KsResult result = ks_success;
+
+        // Group the components by dependency level, static ones don't belong to a module and come first
+        List <List<ComponentBase*>> levels(1);
+        auto addToLevel = [&](ComponentBase* component, uint8_t level) {
+            if (levels.size() <= level) levels.resize(level + 1);
+            levels[level].push_back(component);
+        };
+
+        if (m_Topology != nullptr) {
+            for (const auto& entry: m_Topology->components)
+                addToLevel(entry.component, 0);
+        }
+
+        for (size_t i = 0; i < m_ComponentTable.size(); i++)
+            addToLevel(m_ComponentTable[i], m_ComponentLevels[i]);
+
+#if !KS_QUEUE_CALIBRATION
+        // The first boot has no profile yet, the components then keep the sizes they were constructed with
+        if (FileSystem::GetInstanceRef() != nullptr)
+            _ApplyQueueProfile(KS_QUEUE_PROFILE_FILE);
+#endif
+
+        // Init Components, a level only starts once the levels it depends on are done
+        {
+            BootPool pool;
+            if (pool.GetTaskCount() > 0) m_RegistryMutex = xSemaphoreCreateRecursiveMutex();
+
+            for (uint8_t level = 0; level < levels.size() && result == ks_success; level++) {
+                const auto& components = levels[level];
+                result = pool.Run(components.size(), [&](size_t index, uint8_t task) {
+                    ComponentBase* component = components[index];
+                    return m_BootTimeline.Time(ks_boot_step_component_init, HashID(component->GetName()), level, task,
+                                               [&] { return component->Init(); });
+                });
+            }
         }
 
+        if (m_RegistryMutex != nullptr) vSemaphoreDelete(m_RegistryMutex);
+        m_RegistryMutex = nullptr;
+        if (result != ks_success) KS_THROW(ks_error_component_initialize);
+
+        _ReportMemory();
+
         // PostInit Components
-        for (auto& component: m_Components) {
-            KS_TRY(ks_error_component_post_initialize, component.second->PostInit());
+        for (uint8_t level = 0; level < levels.size() && result == ks_success; level++) {
+            for (auto* component: levels[level]) {
+                result = m_BootTimeline.Time(ks_boot_step_component_post_init, HashID(component->GetName()), level, 0,
+                                            [&] { return component->PostInit(); });
+                if (result != ks_success) break;
+            }
         }
+        if (result != ks_success) KS_THROW(ks_error_component_post_initialize);
+
+        // The timeline is downlinked as a file, a failure to write it must not fail the boot
+        if (FileSystem::GetInstanceRef() != nullptr)
+            m_BootTimeline.Save(KS_BOOT_TIMELINE_FILE);
 
         return {};
     }
 
+    MemoryBudget Framework::_ReportMemory() {
+        MemoryBudget total;
+        _ForEachComponent([&](ComponentBase* component) {
+            MemoryBudget budget = component->GetMemoryBudget();
+            if (budget.GetTotal() == 0) return;
+
+            KS_DEBUGPRINT("[MEM] %-24s stack %6u queues %6u control %5u",
+                          component->GetName().c_str(),
+                          budget.stack, budget.queues, budget.control);
+            total += budget;
+        });
+
+        KS_DEBUGPRINT("[MEM] %-24s stack %6u queues %6u control %5u", "TOTAL", total.stack, total.queues, total.control);
+        KS_DEBUGPRINT("[MEM] static arena %u / %u bytes", StaticArena::GetUsed(), StaticArena::GetCapacity());
+
+        return total;
+    }
+
+    KsResult Framework::_SaveQueueProfile(const String& path) {
+        List <QueueProfileEntry> entries;
+        _ForEachComponent([&](ComponentBase* component) {
+            auto* componentQueued = dynamic_cast<ComponentQueued*>(component);
+            if (componentQueued == nullptr) return;
+
+            QueueProfileEntry entry{ .id = HashID(component->GetName()) };
+            for (uint8_t lane = 0; lane < KS_EVENT_PRIORITY_LANES; lane++)
+                entry.highWater[lane] = componentQueued->GetHighWater(static_cast<KsEventPriority>(lane));
+
+            KS_DEBUGPRINT("[QUEUE] %-24s low %4u normal %4u high %4u",
+                          component->GetName().c_str(),
+                          entry.highWater[ks_event_priority_low],
+                          entry.highWater[ks_event_priority_normal],
+                          entry.highWater[ks_event_priority_high]);
+            entries.push_back(entry);
+        });
+
+        File file(path, KS_OPEN_MODE_WRITE_ONLY | KS_OPEN_MODE_CREATE | KS_OPEN_MODE_TRUNCATE);
+        if (!file.IsOpen()) KS_THROW(ks_error_file_open);
+
+        auto count = static_cast<uint32_t>(entries.size());
+        if (file.Write(&count, sizeof(count)) < 0) KS_THROW(ks_error_file_write);
+        if (file.Write(entries.data(), entries.size() * sizeof(QueueProfileEntry)) < 0) KS_THROW(ks_error_file_write);
+
+        return file.Sync();
+    }
+
+    KsResult Framework::_ApplyQueueProfile(const String& path) {
+        File file(path, KS_OPEN_MODE_READ_ONLY);
+        if (!file.IsOpen()) return ks_error_file_open;
+
+        uint32_t count = 0;
+        if (file.Read(&count, sizeof(count)) != sizeof(count)) KS_THROW(ks_error_file_read);
+
+        Map <KsIdType, QueueProfileEntry> entries;
+        for (uint32_t i = 0; i < count; i++) {
+            QueueProfileEntry entry{};
+            if (file.Read(&entry, sizeof(entry)) != sizeof(entry)) KS_THROW(ks_error_file_read);
+            entries[entry.id] = entry;
+        }
+
+        KsResult result = ks_success;
+        _ForEachComponent([&](ComponentBase* component) {
+            auto* componentQueued = dynamic_cast<ComponentQueued*>(component);
+            if (componentQueued == nullptr) return;
+
+            KS_MAP_FIND(entries, HashID(component->GetName()), it) {
+                for (uint8_t lane = 0; lane < KS_EVENT_PRIORITY_LANES; lane++) {
+                    uint32_t peak = it->second.highWater[lane];
+                    size_t size = peak + (peak * KS_QUEUE_PROFILE_MARGIN + 99) / 100;
+                    if (componentQueued->SetQueueSize(static_cast<KsEventPriority>(lane), size) != ks_success)
+                        result = ks_error_component_queue_created;
+                }
+            }
+        });
+
+        if (result != ks_success) KS_THROW(result);
+        return ks_success;
+    }
+
+    KsResult Framework::_SetTopology(const Topology& topology) {
+        if (m_Topology != nullptr) KS_THROW(ks_error_topology_exists);
+        // The static index of the last entry must stay below s_Unresolved, which has every bit set
+        constexpr size_t maxEntries = BusHandle<>::s_Unresolved - s_StaticIndex;
+        if (topology.components.size() > maxEntries || topology.busses.size() > maxEntries)
+            KS_THROW(ks_error_topology_full);
+
+        // A mistyped name would resolve handles to another object without any error
+        for (const auto& entry: topology.components) {
+            if (HashID(entry.component->GetName()) != entry.id) KS_THROW(ks_error_topology_name);
+            if (_ResolveComponent(entry.id) != ComponentHandle<>::s_Unresolved) KS_THROW(ks_error_component_exists);
+        }
+
+        for (const auto& entry: topology.busses) {
+            if (HashID(entry.bus->GetName()) != entry.id) KS_THROW(ks_error_topology_name);
+            if (_ResolveBus(entry.id) != BusHandle<>::s_Unresolved) KS_THROW(ks_error_bus_exists);
+            KS_TRY(ks_error_bus_component_subscribed, entry.bus->BindSubscriptions(entry.subscriptions));
+        }
+
+        m_Topology = &topology;
+        return ks_success;
+    }
+
     KsResult Framework::_InitModules() {
         Map <KsIdType, Set<KsIdType>> moduleParents;
         Map <KsIdType, Set<KsIdType>> moduleChildren;
 
-        Stack <KsIdType> moduleStack;
-
         // Create dependency graph
         for (const auto&
             [id, module]: m_Modules) {
@@ -34,33 +187,39 @@ namespace kronos {
             }
         }
 
-        // Push modules with no dependencies on the stack
+        // Modules with no dependencies form the first level
+        List <KsIdType> level;
         for (const auto&
             [id, module]: m_Modules) {
             if (moduleParents[id].empty()) {
-                moduleStack.push(id);
+                level.push_back(id);
             }
         }
 
-        // Loop while we still have modules in the stack
-        while (!moduleStack.empty()) {
-            // Pop a module from the stack
-            KsIdType module = moduleStack.top();
-            moduleStack.pop();
+        // Every following level holds the modules whose dependencies are all in earlier levels
+        List <List<IModule*>> levels;
+        while (!level.empty()) {
+            levels.emplace_back();
+            List <KsIdType> nextLevel;
+            for (const auto& module: level) {
+                // Add the module to the list
+                m_ModuleList.push_back(module);
+                m_ModuleLevels[module] = levels.size() - 1;
+                levels.back().push_back(m_Modules[module].get());
 
-            // Add the module to the list
-            m_ModuleList.push_back(module);
+                // Loop over each module that has a dependency on this module
+                for (auto& child: moduleChildren[module]) {
+                    // Remove the dependency from the graph
+                    moduleParents[child].erase(module);
 
-            // Loop over each module that has a dependency on this module
-            for (auto& child: moduleChildren[module]) {
-                // Remove the dependency from the graph
-                moduleParents[child].erase(module);
-
-                // If the child module has no dependencies left to resolve, push it on the stack
-                if (moduleParents[child].empty()) {
-                    moduleStack.push(child);
+                    // If the child module has no dependencies left to resolve, it belongs to the next level
+                    if (moduleParents[child].empty()) {
+                        nextLevel.push_back(child);
+                    }
                 }
             }
+
+            level = std::move(nextLevel);
         }
 
         // Cyclic dependency check
@@ -72,22 +231,97 @@ namespace kronos {
             KS_THROW(ks_error_module_cyclic_dependency);
         }
 
-        // Initialize modules
-        for (const auto& module: m_ModuleList) {
-            KS_TRY(ks_error_module_initialize, m_Modules[module]->Init());
+        // Init Modules a level at a time like the components, the components they create inherit their level
+        KsResult result = ks_success;
+        {
+            BootPool pool;
+            if (pool.GetTaskCount() > 0) m_RegistryMutex = xSemaphoreCreateRecursiveMutex();
+
+            for (uint8_t level = 0; level < levels.size() && result == ks_success; level++) {
+                const auto& modules = levels[level];
+                m_InitLevel = level;
+                result = pool.Run(modules.size(), [&](size_t index, uint8_t task) {
+                    IModule* module = modules[index];
+                    return m_BootTimeline.Time(ks_boot_step_module, HashID(module->GetName()), level, task,
+                                               [&] { return module->Init(); });
+                });
+            }
         }
 
+        if (m_RegistryMutex != nullptr) vSemaphoreDelete(m_RegistryMutex);
+        m_RegistryMutex = nullptr;
+        if (result != ks_success) KS_THROW(ks_error_module_initialize);
+
+        // Components created by the application after its modules may depend on any of them
+        m_InitLevel = levels.size();
+
         return {};
     }
 
     Bus* Framework::_GetBus(const String& name) {
-        KS_ASSERT(m_Busses.contains(name), "Bus with name doesn't exist")
+        RegistryLock lock;
+        KsHandleIndex index = _ResolveBus(HashID(name));
+        KS_ASSERT(index != BusHandle<>::s_Unresolved, "Bus with name doesn't exist")
 
-        KS_MAP_FIND(m_Busses, name, it) {
-            return it->second.get();
-        }
+        if (index == BusHandle<>::s_Unresolved) return nullptr;
         // TODO: Bus should be maybe sent back by ref?
         // KS_THROW(ks_error_bus_missing);
+        return GetBusAt(index);
+    }
+
+    KsHandleIndex Framework::_ResolveBus(KsIdType id) {
+        RegistryLock lock;
+        if (m_Topology != nullptr) {
+            const auto& busses = m_Topology->busses;
+            for (size_t i = 0; i < busses.size(); i++) {
+                if (busses[i].id == id) return s_StaticIndex | i;
+            }
+        }
+
+        KS_MAP_FIND(m_BusIndices, id, it) {
+            return it->second;
+        }
+
+        return BusHandle<>::s_Unresolved;
+    }
+
+    KsHandleIndex Framework::_ResolveComponent(KsIdType id) {
+        RegistryLock lock;
+        if (m_Topology != nullptr) {
+            const auto& components = m_Topology->components;
+            for (size_t i = 0; i < components.size(); i++) {
+                if (components[i].id == id) return s_StaticIndex | i;
+            }
+        }
+
+        KS_MAP_FIND(m_ComponentIndices, id, it) {
+            return it->second;
+        }
+
+        return ComponentHandle<>::s_Unresolved;
+    }
+
+    KsResult Framework::RegisterBus(const String& name, Bus* bus) {
+        RegistryLock lock;
+        auto id = HashID(name);
+        if (_ResolveBus(id) != BusHandle<>::s_Unresolved) KS_THROW(ks_error_bus_exists);
+        if (m_BusTable.size() >= s_StaticIndex) KS_THROW(ks_error_bus_exists);
+
+        m_BusIndices[id] = m_BusTable.size();
+        m_BusTable.push_back(bus);
+        return ks_success;
+    }
+
+    KsResult Framework::RegisterComponent(const String& name, ComponentBase* component) {
+        RegistryLock lock;
+        auto id = HashID(name);
+        if (_ResolveComponent(id) != ComponentHandle<>::s_Unresolved) KS_THROW(ks_error_component_exists);
+        if (m_ComponentTable.size() >= s_StaticIndex) KS_THROW(ks_error_component_exists);
+
+        m_ComponentIndices[id] = m_ComponentTable.size();
+        m_ComponentTable.push_back(component);
+        m_ComponentLevels.push_back(m_InitLevel);
+        return ks_success;
     }
 
     IoDescriptor* Framework::_GetDescriptor(const String& name) {
@@ -101,22 +335,22 @@ namespace kronos {
     }
 
     EventMessage* Framework::_CreateEventMessage(KsEventCodeType eventCode, Bus* returnBus) {
-        Scope <EventMessage> eventMessage = CreateScope<EventMessage>();
+        EventMessage* eventMessage = s_EventMessagePool.Acquire();
+        if (eventMessage == nullptr) return nullptr;
+
         eventMessage->eventCode = eventCode;
         eventMessage->returnBus = returnBus;
-
-        auto* eventMessagePtr = eventMessage.get();
-        m_EventMessages.emplace(
-            eventMessagePtr,
-            std::forward<Scope<EventMessage>>(eventMessage)
-        );
-        return eventMessagePtr;
+        return eventMessage;
     }
 
-    KsResult Framework::_DeleteEventMessage(const EventMessage* eventMessage) {
-        if(m_EventMessages.erase(eventMessage) == 0) KS_THROW(ks_error_event_message_missing);
+    KsResult Framework::_ReleaseEventMessage(const EventMessage* eventMessage) {
+        if (!s_EventMessagePool.Owns(eventMessage)) KS_THROW(ks_error_event_message_missing);
 
-        return ks_success;
+        // Other subscribers are still holding on to the message
+        if (eventMessage->references.fetch_sub(1, std::memory_order_acq_rel) > 1)
+            return ks_success;
+
+        return s_EventMessagePool.Release(eventMessage);
     }
 
 }
\ No newline at end of file
@@ -1,8 +1,11 @@
 #pragma once
 
 #include "ks_io.h"
+#include "ks_boot.h"
 #include "ks_module.h"
 #include "ks_component_active.h"
+#include "ks_handle.h"
+#include "ks_topology.h"
 
 namespace kronos {
     class Bus;
@@ -24,6 +27,29 @@ namespace kronos {
         //! \brief Destructor that deletes the instance to the Framework Singleton
         ~Framework() = default;
 
+        //! \class RegistryLock
+        //! \brief Serializes changes to the bus and component tables while modules and components are initialized in
+        //! parallel.
+        //!
+        //! Outside of the parallel initialization done by _InitModules() and _Start(), the tables are only changed
+        //! from one task at a time and the lock does nothing.
+        class RegistryLock {
+        public:
+            RegistryLock() : m_Mutex(s_Instance->m_RegistryMutex) {
+                if (m_Mutex != nullptr) xSemaphoreTakeRecursive(m_Mutex, portMAX_DELAY);
+            }
+
+            ~RegistryLock() {
+                if (m_Mutex != nullptr) xSemaphoreGiveRecursive(m_Mutex);
+            }
+
+            RegistryLock(const RegistryLock& other) = delete;
+            void operator=(const RegistryLock& other) = delete;
+
+        private:
+            SemaphoreHandle_t m_Mutex;
+        };
+
     public:
         //! \brief Convenience method for static calls. See _AddModule().
         template<typename T, typename... Args>
@@ -55,17 +81,12 @@ namespace kronos {
             return s_Instance->_CreateDescriptor<T, Args...>(name, std::forward<Args>(args)...);
         }
 
+        //! \brief Convenience method for static calls. See _CreateEventMessage().
         template<class T>
         static inline EventMessage* CreateEventMessage(T&& data, KsEventCodeType eventCode, Bus* returnBus = nullptr) {
             return s_Instance->_CreateEventMessage<T>(std::forward<T>(data), eventCode, returnBus);
         }
 
-        template<class T>
-        static inline EventMessage*
-        CreateEventMessage(const T& data, KsEventCodeType eventCode, Bus* returnBus = nullptr) {
-            return s_Instance->_CreateEventMessage<T>(data, eventCode, returnBus);
-        }
-
         //! \brief Convenience method for static calls. See _HasModule().
         template<typename T>
         static inline bool HasModule() {
@@ -79,8 +100,69 @@ namespace kronos {
         //! \brief Convenience method for static calls. See _InitModules().
         KS_SINGLETON_EXPOSE_METHOD(_InitModules, KsResult InitModules());
 
+        //! \brief Convenience method for static calls. See _ReportMemory().
+        KS_SINGLETON_EXPOSE_METHOD(_ReportMemory, MemoryBudget ReportMemory());
+
+        //! \brief Convenience method for static calls. See _SaveQueueProfile().
+        KS_SINGLETON_EXPOSE_METHOD(_SaveQueueProfile,
+                                   KsResult SaveQueueProfile(const String& path = KS_QUEUE_PROFILE_FILE),
+                                   path);
+
+        //! \brief Convenience method for static calls. See _ApplyQueueProfile().
+        KS_SINGLETON_EXPOSE_METHOD(_ApplyQueueProfile,
+                                   KsResult ApplyQueueProfile(const String& path = KS_QUEUE_PROFILE_FILE),
+                                   path);
+
+        //! \brief Convenience method for static calls. See _SetTopology().
+        KS_SINGLETON_EXPOSE_METHOD(_SetTopology, KsResult SetTopology(const Topology& topology), topology);
+
+        //! \brief Fetches a bus by name. Code that looks the same bus up repeatedly should keep a BusHandle instead.
         KS_SINGLETON_EXPOSE_METHOD(_GetBus, Bus* GetBus(const String& name), name);
 
+        //! \brief Fetches a bus created with a specific bus class, such as a TypedBus.
+        //!
+        //! \tparam T The class the bus was created with.
+        //! \param name The name of the bus.
+        template<typename T>
+        static inline T* GetBus(const String& name) {
+            static_assert(std::is_base_of_v<Bus, T>, "T must extend Bus!");
+
+            Bus* bus = s_Instance->_GetBus(name);
+#ifdef KS_DEBUG
+            KS_ASSERT(dynamic_cast<T*>(bus) != nullptr, "Bus was created with a different class")
+#endif
+
+            return static_cast<T*>(bus);
+        }
+
+        //! \brief Convenience method for static calls. See _ResolveBus().
+        KS_SINGLETON_EXPOSE_METHOD(_ResolveBus, KsHandleIndex ResolveBus(KsIdType id), id);
+
+        //! \brief Convenience method for static calls. See _ResolveComponent().
+        KS_SINGLETON_EXPOSE_METHOD(_ResolveComponent, KsHandleIndex ResolveComponent(KsIdType id), id);
+
+        //! \brief Fetches a bus from the index a handle was resolved to.
+        //!
+        //! Safe during the parallel initialization, see RegistryLock.
+        static inline Bus* GetBusAt(KsHandleIndex index) {
+            if (index & s_StaticIndex) return s_Instance->m_Topology->busses[index & ~s_StaticIndex].bus;
+
+            // The table may be growing on another boot task
+            RegistryLock lock;
+            return s_Instance->m_BusTable[index];
+        }
+
+        //! \brief Fetches a component from the index a handle was resolved to.
+        //!
+        //! Safe during the parallel initialization, see RegistryLock.
+        static inline ComponentBase* GetComponentAt(KsHandleIndex index) {
+            if (index & s_StaticIndex) return s_Instance->m_Topology->components[index & ~s_StaticIndex].component;
+
+            // The table may be growing on another boot task
+            RegistryLock lock;
+            return s_Instance->m_ComponentTable[index];
+        }
+
         KS_SINGLETON_EXPOSE_METHOD(_GetDescriptor, IoDescriptor* GetDescriptor(const String& name), name);
 
         KS_SINGLETON_EXPOSE_METHOD(_CreateEventMessage,
@@ -89,12 +171,27 @@ namespace kronos {
                                    eventCode,
                                    returnBus);
 
-        KS_SINGLETON_EXPOSE_METHOD(_DeleteEventMessage,
-                                   KsResult DeleteEventMessage(const EventMessage* eventMessage),
+        KS_SINGLETON_EXPOSE_METHOD(_ReleaseEventMessage,
+                                   KsResult ReleaseEventMessage(const EventMessage* eventMessage),
                                    eventMessage);
 
+        //! \brief Getter for the timeline of the last boot, see _Start().
+        static inline const BootTimeline& GetBootTimeline() {
+            return s_Instance->m_BootTimeline;
+        }
+
+        //! \brief Getter for the usage counters of the event message pool.
+        static inline PoolStats GetEventMessagePoolStats() {
+            return s_EventMessagePool.GetStats();
+        }
+
     private:
-        //! \brief Initializes all the components and starts the FreeRTOS sched
+        //! \brief Initializes all the components and records the boot timeline.
+        //!
+        //! Components are initialized one dependency level at a time: a component inherits the level of the module
+        //! that created it, and the components of a level are initialized in parallel on a BootPool once every
+        //! earlier level is done. PostInit() then runs on every component, level by level, on the calling task.
+        //! Every step is timed and the timeline is written to KS_BOOT_TIMELINE_FILE when a file system exists.
         KsResult _Start();
 
         //! \brief Initializes and adds a module to the framework.
@@ -129,6 +226,7 @@ namespace kronos {
         template<class T, typename... Args>
         T* _CreateComponent(const std::string& name, Args&& ... args) {
             static_assert(std::is_base_of_v<ComponentBase, T>, "T must extend ComponentBase!");
+            RegistryLock lock;
 
             if (m_Components.contains(name)) {
                 // Component already created
@@ -137,18 +235,16 @@ namespace kronos {
             }
 
             auto ref = CreateRef<T>(name, std::forward<Args>(args)...);
+            if (RegisterComponent(name, ref.get()) != ks_success) return nullptr;
             m_Components[name] = ref;
 
-            if constexpr (std::is_base_of_v<ComponentActive, T>) {
-                m_ActiveComponents.push_back(name);
-            }
-
             return ref.get();
         }
 
         template<typename T>
         KsResult _CreateSingletonComponent() {
             static_assert(std::is_base_of_v<ComponentBase, T>, "T must extend ComponentBase!");
+            RegistryLock lock;
 
             T::CreateInstance();
             auto ref = T::GetInstanceRef();
@@ -159,10 +255,8 @@ namespace kronos {
                 KS_THROW(ks_error_component_exists);
             }
 
+            KS_TRY(ks_error_component_exists, RegisterComponent(name, ref.get()));
             m_Components[name] = ref;
-            if constexpr (std::is_base_of_v<ComponentActive, T>) {
-                m_ActiveComponents.push_back(name);
-            }
 
             return ks_success;
         }
@@ -177,6 +271,7 @@ namespace kronos {
         template<class T, typename... Args>
         T* _CreateBus(const std::string& name, Args&& ... args) {
             static_assert(std::is_base_of_v<Bus, T>, "T must extend Bus!");
+            RegistryLock lock;
 
             if (m_Busses.contains(name)) {
                 // Bus already created
@@ -185,6 +280,7 @@ namespace kronos {
             }
 
             auto ref = CreateRef<T>(name, std::forward<Args>(args)...);
+            if (RegisterBus(name, ref.get()) != ks_success) return nullptr;
             m_Busses[name] = ref;
             return ref.get();
         }
@@ -199,41 +295,43 @@ namespace kronos {
 //                KS_THROW(ks_error_bus_exists);
             }
 
-            auto ref = CreateRef<T>(std::forward<Args>(args)...);
+            Ref<T> ref;
+            m_BootTimeline.Time(ks_boot_step_driver, HashID(name), 0, 0, [&] {
+                ref = CreateRef<T>(std::forward<Args>(args)...);
+                return ks_success;
+            });
+
             m_Drivers[name] = ref;
             return ref.get();
         }
 
+        //! \brief Takes an event message from the pool and fills it.
+        //!
+        //! \tparam T The type of the data carried by the message.
+        //! \param data The data carried by the message.
+        //! \param eventCode The event code of the message.
+        //! \param returnBus The bus on which a response should be published, if any.
+        //! \return The event message, nullptr if the pool is exhausted.
         template<class T>
         EventMessage* _CreateEventMessage(T&& data, KsEventCodeType eventCode, Bus* returnBus = nullptr) {
-            Scope <EventMessage> eventMessage = std::make_unique<EventMessage>();
-            eventMessage->eventCode = eventCode;
-            eventMessage->data = std::make_any<T>(std::forward<T>(data));
-            eventMessage->returnBus = returnBus;
-
-            auto* eventMessagePtr = eventMessage.get();
-            m_EventMessages.emplace(eventMessagePtr, std::forward<Scope < EventMessage>>
-            (eventMessage));
+            EventMessage* eventMessage = _CreateEventMessage(eventCode, returnBus);
+            if (eventMessage == nullptr) return nullptr;
 
-            return eventMessagePtr;
-        }
+            if (eventMessage->data.Emplace<std::decay_t<T>>(std::forward<T>(data)) != ks_success) {
+                _ReleaseEventMessage(eventMessage);
+                return nullptr;
+            }
 
-        template<class T>
-        EventMessage* _CreateEventMessage(const T& data, KsEventCodeType eventCode, Bus* returnBus = nullptr) {
-            Scope <EventMessage> eventMessage = std::make_unique<EventMessage>();
-            eventMessage->eventCode = eventCode;
-            eventMessage->data = std::make_any<T>(data);
-            eventMessage->returnBus = returnBus;
-
-            auto* eventMessagePtr = eventMessage.get();
-            m_EventMessages.emplace(eventMessagePtr, std::forward<Scope < EventMessage>>
-            (eventMessage));
-            return eventMessagePtr;
+            return eventMessage;
         }
 
         EventMessage* _CreateEventMessage(KsEventCodeType eventCode, Bus* returnBus = nullptr);
 
-        KsResult _DeleteEventMessage(const EventMessage* eventMessage);
+        //! \brief Drops one reference to an event message and gives it back to the pool after the last one.
+        //!
+        //! \param eventMessage The event message handle returned by _CreateEventMessage().
+        //! \return ks_error_event_message_missing if the message was not created by the framework.
+        KsResult _ReleaseEventMessage(const EventMessage* eventMessage);
 
         //!
         //! \tparam T
@@ -243,26 +341,146 @@ namespace kronos {
             return m_Modules.contains(ClassID<T>());
         }
 
-        //! \brief
+        //! \brief Sorts the modules in dependency levels and initializes them level by level.
         //!
-        //! \param moduleList
-        //! \return
+        //! A module is one level above the deepest module it depends on, and the modules of a level are initialized
+        //! in parallel on a BootPool once every module of the previous levels is. The components a module creates
+        //! inherit its level and are initialized in parallel by _Start(). Components created after this call are
+        //! given the level following the last module.
+        //!
+        //! \return ks_error_module_cyclic_dependency if the dependencies of the modules form a cycle,
+        //! ks_error_module_initialize if a module failed to initialize.
         KsResult _InitModules();
 
+        //! \brief Registers the statically allocated components and busses of the application.
+        //!
+        //! Nothing is allocated: handles resolve straight to the entries of the topology and every bus delivers
+        //! from its static subscription table. Must be called before _Start(), at most once.
+        //!
+        //! \param topology The topology, it must outlive the framework.
+        //! \return ks_error_topology_exists if a topology was already set, ks_error_topology_full if it has too many
+        //! components or busses, ks_error_topology_name if the name of an entry isn't the name of its object, or an
+        //! error if a name is already taken.
+        KsResult _SetTopology(const Topology& topology);
+
+        //! \brief Prints the memory reserved by every component and the usage of the static arena.
+        //!
+        //! Called by _Start() once every component is initialized, so that the report matches what the
+        //! components actually created.
+        //!
+        //! \return The memory reserved by all the components.
+        MemoryBudget _ReportMemory();
+
+        //! \brief Writes the high-water marks of the lanes of every queued component to a queue profile.
+        //!
+        //! Meant to be called after running a representative load in calibration mode (KS_QUEUE_CALIBRATION), the
+        //! marks are also printed so that the sizes can be carried over to the constructors of the components.
+        //!
+        //! \param path The file the profile is written to, it is overwritten.
+        KsResult _SaveQueueProfile(const String& path);
+
+        //! \brief Sizes the lanes of every queued component from a queue profile.
+        //!
+        //! Each lane gets its high-water mark plus KS_QUEUE_PROFILE_MARGIN percent. Components missing from the
+        //! profile keep the sizes they were constructed with. Called by _Start() before the components initialize,
+        //! as the lanes can't be resized once created.
+        //!
+        //! \param path The file the profile is read from.
+        //! \return ks_error_file_open if there is no profile yet.
+        KsResult _ApplyQueueProfile(const String& path);
+
+        //! \brief Calls f with every component, static ones first then the others in creation order.
+        template<typename F>
+        void _ForEachComponent(F&& f) {
+            if (m_Topology != nullptr) {
+                for (const auto& entry: m_Topology->components)
+                    f(entry.component);
+            }
+
+            RegistryLock lock;
+            for (auto* component: m_ComponentTable)
+                f(component);
+        }
+
         Bus* _GetBus(const String& name);
 
+        //! \brief Finds the dense index of a bus from its hashed name.
+        //!
+        //! \param id The HashID() of the name of the bus.
+        //! \return The index of the bus, Handle::s_Unresolved if no bus has that name.
+        KsHandleIndex _ResolveBus(KsIdType id);
+
+        //! \brief Finds the dense index of a component from its hashed name.
+        //!
+        //! \param id The HashID() of the name of the component.
+        //! \return The index of the component, Handle::s_Unresolved if no component has that name.
+        KsHandleIndex _ResolveComponent(KsIdType id);
+
+        //! \brief Assigns the next dense index to a new bus.
+        //!
+        //! \return ks_error_bus_exists if the hashed name collides with another bus.
+        KsResult RegisterBus(const String& name, Bus* bus);
+
+        //! \brief Assigns the next dense index to a new component.
+        //!
+        //! \return ks_error_component_exists if the hashed name collides with another component.
+        KsResult RegisterComponent(const String& name, ComponentBase* component);
+
         IoDescriptor* _GetDescriptor(const String& name);
 
     private:
         List <KsIdType> m_ModuleList;
+        //! Dependency level of every module, see _InitModules()
+        Map <KsIdType, uint8_t> m_ModuleLevels;
+        //! Dependency level of every component of m_ComponentTable, inherited from the module that created it
+        List <uint8_t> m_ComponentLevels;
+        //! Level given to the components being created
+        uint8_t m_InitLevel = 0;
+        BootTimeline m_BootTimeline;
+        //! Taken by RegistryLock while modules or components are initialized in parallel, nullptr otherwise
+        SemaphoreHandle_t m_RegistryMutex = nullptr;
         Map <KsIdType, Scope<IModule>> m_Modules;
         Map <String, Ref<ComponentBase>> m_Components;
-        List <String> m_ActiveComponents;
         Map <String, Ref<Bus>> m_Busses;
+        //! Every bus in creation order, indexed by the handles
+        List <Bus*> m_BusTable;
+        Map <KsIdType, KsHandleIndex> m_BusIndices;
+        //! Every component in creation order, indexed by the handles
+        List <ComponentBase*> m_ComponentTable;
+        Map <KsIdType, KsHandleIndex> m_ComponentIndices;
+        //! Statically allocated components and busses, see _SetTopology()
+        const Topology* m_Topology = nullptr;
+
+        //! Flag set on the handle indices referring to the entries of m_Topology
+        static constexpr KsHandleIndex s_StaticIndex = 0x8000;
         Map <String, Ref<IoDescriptor>> m_Drivers;
-        Map<const EventMessage*, Scope < EventMessage>> m_EventMessages;
         Ref<Queue<ErrorInfo>> m_StackTrace;
 
+        //! Statically allocated storage for every event message in flight
+        static Pool<EventMessage, KS_EVENT_MESSAGE_POOL_SIZE> s_EventMessagePool;
+
     };
 
+    template<typename T>
+    T* Handle<T>::Get() const {
+        KsHandleIndex index = m_Index.load(std::memory_order_relaxed);
+        if (index == s_Unresolved) {
+            if constexpr (std::is_base_of_v<Bus, T>) {
+                index = Framework::ResolveBus(m_Id);
+            } else {
+                static_assert(std::is_base_of_v<ComponentBase, T>, "T must extend Bus or ComponentBase!");
+                index = Framework::ResolveComponent(m_Id);
+            }
+
+            if (index == s_Unresolved) return nullptr;
+            m_Index.store(index, std::memory_order_relaxed);
+        }
+
+        if constexpr (std::is_base_of_v<Bus, T>) {
+            return static_cast<T*>(Framework::GetBusAt(index));
+        } else {
+            return static_cast<T*>(Framework::GetComponentAt(index));
+        }
+    }
+
 }
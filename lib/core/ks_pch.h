@@ -15,4 +15,7 @@
 #include "ks_event_codes.h"
 #include "ks_conf.h"
 
+#include "ks_static_arena.h"
 #include "ks_queue.h"
+#include "ks_pool.h"
+#include "ks_payload.h"
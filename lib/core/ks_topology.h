@@ -0,0 +1,48 @@
+#pragma once
+
+#include "ks_component_base.h"
+
+namespace kronos {
+    class Bus;
+
+    //! \struct TopologyComponent
+    //! \brief A statically allocated component declared in a Topology.
+    struct TopologyComponent {
+        //! \param name The name of the component, it must match the name the component was constructed with.
+        //! \param component The component, it must outlive the framework.
+        constexpr TopologyComponent(StringView name, ComponentBase* component)
+            : id(HashID(name)), component(component) {}
+
+        //! HashID() of the name of the component
+        KsIdType id;
+        ComponentBase* component;
+    };
+
+    //! \struct TopologyBus
+    //! \brief A statically allocated bus and its subscribers declared in a Topology.
+    struct TopologyBus {
+        //! \param name The name of the bus, it must match the name the bus was constructed with.
+        //! \param bus The bus, it must outlive the framework.
+        //! \param subscriptions The subscribers of the bus, the bus delivers straight from this table.
+        constexpr TopologyBus(StringView name, Bus* bus, std::span<Subscription> subscriptions = {})
+            : id(HashID(name)), bus(bus), subscriptions(subscriptions) {}
+
+        //! HashID() of the name of the bus
+        KsIdType id;
+        Bus* bus;
+        std::span<Subscription> subscriptions;
+    };
+
+    //! \struct Topology
+    //! \brief Compile-time description of the components and busses of an application and how they are wired.
+    //!
+    //! Every component, bus and subscription table referenced by a topology lives in static storage, so the
+    //! topology itself can be declared constexpr and placed in read-only memory. Framework::SetTopology()
+    //! registers it without allocating: handles resolve to its entries and busses deliver from its subscription
+    //! tables directly. Components and busses created at runtime through the dynamic API coexist with it.
+    struct Topology {
+        std::span<const TopologyComponent> components;
+        std::span<const TopologyBus> busses;
+    };
+
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+//! Dense index of a bus or component in the tables of the framework
+typedef uint16_t KsHandleIndex;
+
+namespace kronos {
+    class Bus;
+    class ComponentBase;
+
+    //! \class Handle
+    //! \brief Interned reference to a named bus or component.
+    //!
+    //! The name is hashed with HashID() when the handle is constructed, which happens at compile time for string
+    //! literals. The first call to Get() resolves that id to the dense index the framework assigned when the bus or
+    //! component was created, every later call is a single array access. Handles are meant to be kept around,
+    //! as members or statics, by code that looks the same object up repeatedly.
+    //!
+    //! \tparam T The class the bus or component was created with.
+    template<typename T>
+    class Handle {
+    public:
+        //! \brief Constructor to create a handle from the name of a bus or component.
+        //!
+        //! \param name The name the bus or component was created with.
+        constexpr explicit Handle(StringView name) : m_Name(name), m_Id(HashID(name)) {}
+
+        Handle(const Handle& other) = delete;
+        void operator=(const Handle& other) = delete;
+
+        //! \brief Fetches the bus or component, resolving the handle on first use.
+        //!
+        //! \return The bus or component, nullptr if none was created with that name.
+        T* Get() const;
+
+        T* operator->() const { return Get(); }
+
+        //! \brief Getter for the hashed name of the handle.
+        [[nodiscard]] constexpr KsIdType GetId() const { return m_Id; }
+
+        //! \brief Getter for the name of the handle.
+        [[nodiscard]] constexpr StringView GetName() const { return m_Name; }
+
+        //! \brief Checks whether the handle already knows the index of its bus or component.
+        [[nodiscard]] bool IsResolved() const {
+            return m_Index.load(std::memory_order_relaxed) != s_Unresolved;
+        }
+
+        //! Index of a handle that hasn't been resolved yet
+        static constexpr KsHandleIndex s_Unresolved = UINT16_MAX;
+
+    private:
+        StringView m_Name;
+        KsIdType m_Id;
+        //! Cached index, resolving twice from two tasks stores the same value so relaxed ordering is enough
+        mutable std::atomic<KsHandleIndex> m_Index{ s_Unresolved };
+    };
+
+    //! Handle to a bus, see Framework::CreateBus()
+    template<typename T = Bus>
+    using BusHandle = Handle<T>;
+
+    //! Handle to a component, see Framework::CreateComponent()
+    template<typename T = ComponentBase>
+    using ComponentHandle = Handle<T>;
+
+}
@@ -0,0 +1,142 @@
+#pragma once
+
+namespace kronos {
+
+    //! \struct PayloadBlock
+    //! \brief Storage for a payload too large to be kept inline in an event message.
+    struct PayloadBlock {
+        alignas(std::max_align_t) uint8_t data[KS_PAYLOAD_BLOCK_SIZE];
+    };
+
+    //! \class Payload
+    //! \brief Type-tagged storage for the data carried by an event message.
+    //!
+    //! Values up to KS_PAYLOAD_INLINE_SIZE bytes are constructed inside the payload itself. Larger values are
+    //! constructed in a block taken from a statically allocated pool, so storing a payload never touches the heap.
+    //! A payload can also adopt a value it did not construct, such as a buffer loaned by a bus, in which case the
+    //! owner of that buffer is called back when the payload is reset.
+    //! Every payload remembers the compile-time TypeID() of its value. Debug builds check it on every access,
+    //! release builds trust the caller and cast directly.
+    class Payload {
+    public:
+        Payload() = default;
+
+        ~Payload() {
+            Reset();
+        }
+
+        Payload(const Payload& other) = delete;
+        void operator=(const Payload& other) = delete;
+
+        //! \brief Constructs a new value in the payload, destroying the previous one.
+        //!
+        //! \tparam T The type of the value.
+        //! \param args The constructor arguments of the value.
+        //! \return ks_error_payload_pool_exhausted if the value needs a block and none is left.
+        template<typename T, typename... Args>
+        KsResult Emplace(Args&& ... args) {
+            static_assert(sizeof(T) <= KS_PAYLOAD_BLOCK_SIZE, "Payload type is larger than KS_PAYLOAD_BLOCK_SIZE!");
+            static_assert(alignof(T) <= alignof(std::max_align_t), "Payload type is over-aligned!");
+
+            Reset();
+
+            if constexpr (FitsInline<T>()) {
+                m_Value = new(m_Inline) T(std::forward<Args>(args)...);
+
+                if constexpr (!std::is_trivially_destructible_v<T>) {
+                    m_Destroy = [](void* value, void* owner) { static_cast<T*>(value)->~T(); };
+                }
+            } else {
+                PayloadBlock* block = s_BlockPool.Acquire();
+                if (block == nullptr) KS_THROW(ks_error_payload_pool_exhausted);
+
+                m_Value = new(block->data) T(std::forward<Args>(args)...);
+                m_Owner = block;
+                m_Destroy = [](void* value, void* owner) {
+                    static_cast<T*>(value)->~T();
+                    s_BlockPool.Release(static_cast<PayloadBlock*>(owner));
+                };
+            }
+
+            m_TypeId = TypeID<T>();
+            return ks_success;
+        }
+
+        //! \brief Makes the payload refer to a value owned by someone else, destroying the previous one.
+        //!
+        //! \tparam T The type of the value.
+        //! \param value The value, it must stay valid until the payload is reset.
+        //! \param release Function called with the value and its owner when the payload is reset.
+        //! \param owner The owner of the value, passed back to the release function.
+        template<typename T>
+        void Adopt(T* value, void (* release)(void* value, void* owner), void* owner = nullptr) {
+            Reset();
+
+            m_Value = value;
+            m_Owner = owner;
+            m_Destroy = release;
+            m_TypeId = TypeID<T>();
+        }
+
+        //! \brief Accesses the value stored in the payload.
+        //!
+        //! \tparam T The type of the value, it must match the type that was emplaced.
+        //! \return A reference to the value.
+        template<typename T>
+        [[nodiscard]] const T& Get() const {
+#ifdef KS_DEBUG
+            KS_ASSERT(Is<T>(), "Payload accessed with the wrong type")
+#endif
+            return *static_cast<const T*>(m_Value);
+        }
+
+        //! \brief Checks whether the payload holds a value of type T.
+        template<typename T>
+        [[nodiscard]] bool Is() const {
+            return m_TypeId == TypeID<T>();
+        }
+
+        //! \brief Checks whether the payload holds a value.
+        [[nodiscard]] bool HasValue() const {
+            return m_TypeId != 0;
+        }
+
+        //! \brief Destroys the value and gives its storage back to its owner if it had one.
+        void Reset() {
+            if (m_Destroy != nullptr)
+                m_Destroy(m_Value, m_Owner);
+
+            m_Value = nullptr;
+            m_Owner = nullptr;
+            m_Destroy = nullptr;
+            m_TypeId = 0;
+        }
+
+        //! \brief Checks at compile time whether a value of type T is stored inline.
+        template<typename T>
+        static constexpr bool FitsInline() {
+            return sizeof(T) <= KS_PAYLOAD_INLINE_SIZE;
+        }
+
+        //! \brief Getter for the usage counters of the block pool used by large payloads.
+        static PoolStats GetBlockPoolStats() {
+            return s_BlockPool.GetStats();
+        }
+
+    private:
+        //! Inline storage for small values
+        alignas(std::max_align_t) uint8_t m_Inline[KS_PAYLOAD_INLINE_SIZE]{};
+        //! The stored value, either inline, in a pooled block or adopted
+        void* m_Value = nullptr;
+        //! Owner of the storage of the value when it is not inline
+        void* m_Owner = nullptr;
+        //! Destroys the value and frees its storage, nullptr if there is nothing to do
+        void (* m_Destroy)(void* value, void* owner) = nullptr;
+        //! TypeID() of the stored value, 0 if the payload is empty
+        KsIdType m_TypeId = 0;
+
+        //! Blocks shared by every payload too large to be stored inline
+        static inline Pool<PayloadBlock, KS_PAYLOAD_BLOCK_COUNT> s_BlockPool{};
+    };
+
+}
@@ -0,0 +1,165 @@
+#pragma once
+
+namespace kronos {
+
+    //! \struct PoolStats
+    //! \brief Snapshot of the usage counters of a Pool.
+    struct PoolStats {
+        //! Number of objects currently handed out by the pool
+        uint32_t inUse;
+        //! Highest number of objects handed out at the same time
+        uint32_t highWaterMark;
+        //! Total number of successful acquisitions
+        uint32_t acquired;
+        //! Total number of objects given back to the pool
+        uint32_t released;
+        //! Number of acquisitions that failed because the pool was empty
+        uint32_t exhausted;
+    };
+
+    //! \class Pool
+    //! \brief Fixed-capacity object pool with a lock-free free list.
+    //!
+    //! Objects are constructed in place inside statically sized storage, so acquiring and releasing never
+    //! touches the heap. The free list is a tagged Treiber stack, which makes Acquire() and Release() safe to
+    //! call concurrently from any task or interrupt without taking a lock.
+    //!
+    //! \tparam T The type of the pooled objects.
+    //! \tparam Capacity The number of objects the pool can hand out at the same time.
+    template<typename T, size_t Capacity>
+    class Pool {
+        static_assert(Capacity > 0 && Capacity < UINT16_MAX, "Pool capacity must fit in a 16-bit index!");
+
+    public:
+        Pool() {
+            for (size_t i = 0; i < Capacity; i++)
+                m_Next[i].store(i + 1 < Capacity ? i + 1 : s_NullIndex, std::memory_order_relaxed);
+            m_Head.store(Pack(0, 0), std::memory_order_release);
+        }
+
+        Pool(const Pool& other) = delete;
+        void operator=(const Pool& other) = delete;
+
+        //! \brief Takes an object out of the pool and constructs it in place.
+        //!
+        //! \param args The constructor arguments of the object.
+        //! \return A pointer to the new object, nullptr if the pool is exhausted.
+        template<typename... Args>
+        T* Acquire(Args&& ... args) {
+            uint16_t index;
+            if (!PopFree(&index)) {
+                m_Exhausted.fetch_add(1, std::memory_order_relaxed);
+                return nullptr;
+            }
+
+            T* object = new(m_Slots[index].data) T(std::forward<Args>(args)...);
+
+            uint32_t inUse = m_InUse.fetch_add(1, std::memory_order_relaxed) + 1;
+            uint32_t highWaterMark = m_HighWaterMark.load(std::memory_order_relaxed);
+            while (inUse > highWaterMark &&
+                   !m_HighWaterMark.compare_exchange_weak(highWaterMark, inUse, std::memory_order_relaxed));
+
+            m_Acquired.fetch_add(1, std::memory_order_relaxed);
+            return object;
+        }
+
+        //! \brief Destroys an object and gives its slot back to the pool.
+        //!
+        //! \param object An object previously returned by Acquire().
+        //! \return ks_success, or ks_error if the object does not belong to this pool.
+        KsResult Release(const T* object) {
+            if (!Owns(object)) return ks_error;
+
+            object->~T();
+            PushFree(IndexOf(object));
+
+            m_InUse.fetch_sub(1, std::memory_order_relaxed);
+            m_Released.fetch_add(1, std::memory_order_relaxed);
+            return ks_success;
+        }
+
+        //! \brief Checks whether an object lives inside the storage of this pool.
+        [[nodiscard]] bool Owns(const T* object) const {
+            auto address = reinterpret_cast<uintptr_t>(object);
+            auto begin = reinterpret_cast<uintptr_t>(&m_Slots[0]);
+            auto end = reinterpret_cast<uintptr_t>(&m_Slots[Capacity]);
+
+            return address >= begin && address < end && (address - begin) % sizeof(Slot) == 0;
+        }
+
+        //! \brief Getter for the usage counters of the pool.
+        [[nodiscard]] PoolStats GetStats() const {
+            return {
+                .inUse = m_InUse.load(std::memory_order_relaxed),
+                .highWaterMark = m_HighWaterMark.load(std::memory_order_relaxed),
+                .acquired = m_Acquired.load(std::memory_order_relaxed),
+                .released = m_Released.load(std::memory_order_relaxed),
+                .exhausted = m_Exhausted.load(std::memory_order_relaxed)
+            };
+        }
+
+        //! \brief Getter for the capacity of the pool.
+        [[nodiscard]] static constexpr size_t GetCapacity() {
+            return Capacity;
+        }
+
+    private:
+        //! Index marking the end of the free list
+        static constexpr uint16_t s_NullIndex = UINT16_MAX;
+
+        //! \brief Packs an ABA tag and a slot index into a single free list head.
+        static constexpr uint32_t Pack(uint32_t tag, uint16_t index) {
+            return (tag << 16) | index;
+        }
+
+        [[nodiscard]] uint16_t IndexOf(const T* object) const {
+            return (reinterpret_cast<uintptr_t>(object) - reinterpret_cast<uintptr_t>(&m_Slots[0])) / sizeof(Slot);
+        }
+
+        bool PopFree(uint16_t* index) {
+            uint32_t head = m_Head.load(std::memory_order_acquire);
+            while (true) {
+                uint16_t top = head & 0xFFFF;
+                if (top == s_NullIndex) return false;
+
+                uint32_t next = Pack((head >> 16) + 1, m_Next[top].load(std::memory_order_relaxed));
+                if (m_Head.compare_exchange_weak(head, next, std::memory_order_acq_rel, std::memory_order_acquire)) {
+                    *index = top;
+                    return true;
+                }
+            }
+        }
+
+        void PushFree(uint16_t index) {
+            uint32_t head = m_Head.load(std::memory_order_relaxed);
+            do {
+                m_Next[index].store(head & 0xFFFF, std::memory_order_relaxed);
+            } while (!m_Head.compare_exchange_weak(
+                head,
+                Pack((head >> 16) + 1, index),
+                std::memory_order_release,
+                std::memory_order_relaxed
+            ));
+        }
+
+    private:
+        //! Raw storage for a single object
+        struct Slot {
+            alignas(T) uint8_t data[sizeof(T)];
+        };
+
+        //! Object storage
+        Slot m_Slots[Capacity]{};
+        //! Next free slot for each slot in the free list
+        std::atomic<uint16_t> m_Next[Capacity];
+        //! Head of the free list, the upper 16 bits hold the ABA tag
+        std::atomic<uint32_t> m_Head{};
+
+        std::atomic<uint32_t> m_InUse{ 0 };
+        std::atomic<uint32_t> m_HighWaterMark{ 0 };
+        std::atomic<uint32_t> m_Acquired{ 0 };
+        std::atomic<uint32_t> m_Released{ 0 };
+        std::atomic<uint32_t> m_Exhausted{ 0 };
+    };
+
+}
@@ -14,14 +14,46 @@ namespace kronos {
     public:
         explicit Queue(QueueHandle_t queue, size_t length = 10) : m_Length(length), m_Queue(queue) {}
 
-        ~Queue() { vQueueDelete(m_Queue); }
+        ~Queue() { if (m_Queue != nullptr) vQueueDelete(m_Queue); }
 
+        //! \brief Creates a queue and its kernel queue, check IsValid() for the latter.
+        //!
+        //! In static allocation mode the queue is placed in the StaticArena and is never released.
+        //!
+        //! \param length Number of elements the queue holds.
+        //! \return nullptr if the static arena is exhausted.
         static Ref<Queue<T>> Create(size_t length = KS_QUEUE_DEFAULT_SIZE) {
+#if KS_STATIC_ALLOCATION
+            // The queue object, which holds the control block, and its storage share a single arena allocation, so
+            // an exhausted arena loses nothing
+            constexpr size_t alignment = StaticArena::s_Alignment;
+            constexpr size_t objectSize = (sizeof(Queue<T>) + alignment - 1) & ~(alignment - 1);
+            auto* memory = static_cast<uint8_t*>(StaticArena::Allocate(objectSize + length * sizeof(T)));
+            if (memory == nullptr) return nullptr;
+
+            auto* queue = new(memory) Queue<T>(nullptr, length);
+            queue->m_Queue = xQueueCreateStatic(length, sizeof(T), memory + objectSize, &queue->m_Control);
+
+            // The arena never gives memory back, so the queue lives as long as the application and the handle owns
+            // nothing, which also keeps the reference count off the heap
+            return Ref<Queue<T>>(Ref<void>(), queue);
+#else
             QueueHandle_t handle = xQueueCreate(length, sizeof(T));
 
             // if(handle == 0) KS_THROW(ks_error_queue_create);
 
             return CreateRef<Queue<T>>(handle, length);
+#endif
+        }
+
+        //! \brief Checks whether the kernel queue could be created.
+        [[nodiscard]] bool IsValid() const {
+            return m_Queue != nullptr;
+        }
+
+        //! \brief Getter for the memory reserved by the queue, its storage and its control block.
+        [[nodiscard]] MemoryBudget GetMemoryBudget() const {
+            return { .queues = m_Length * sizeof(T), .control = sizeof(StaticQueue_t) };
         }
 
         //! \brief Enqueues element into the queue.
@@ -35,6 +67,30 @@ namespace kronos {
             return ks_success;
         }
 
+        //! \brief Enqueues element into the queue, where a full queue is expected and not an error.
+        //!
+        //! \param element the element object to insert into the queue
+        //! \param ticksToWait ticks to wait for room in the queue
+        //! \return ks_error_queue_push if the queue is still full, without recording it in the stack trace
+        KsResult TryPush(const T& element, TickType_t ticksToWait = 0) {
+            if(xQueueSend(m_Queue, &element, ticksToWait) != pdPASS) return ks_error_queue_push;
+
+            return ks_success;
+        }
+
+        //! \brief Enqueues element into the queue from an interrupt.
+        //!
+        //! Never blocks and does not record the error in the stack trace, which isn't safe to use from an interrupt.
+        //!
+        //! \param element the element object to insert into the queue
+        //! \param higherPriorityTaskWoken set to pdTRUE if a task should be switched to when the interrupt exits
+        //! \return ks_error_queue_push if the queue is full
+        KsResult PushFromISR(const T& element, BaseType_t* higherPriorityTaskWoken) {
+            if(xQueueSendFromISR(m_Queue, &element, higherPriorityTaskWoken) != pdPASS) return ks_error_queue_push;
+
+            return ks_success;
+        }
+
         //! \brief Dequeues element from the queue.
         //!
         //! \param pElement pointer to the element
@@ -46,6 +102,28 @@ namespace kronos {
             return ks_success;
         }
 
+        //! \brief Dequeues element from the queue, where an empty queue is expected and not an error.
+        //!
+        //! \param pElement pointer to the element
+        //! \param ticksToWait ticks to wait for an element
+        //! \return ks_error_queue_pop if the queue is still empty, without recording it in the stack trace
+        KsResult TryPop(T* pElement, TickType_t ticksToWait = 0) {
+            if(xQueueReceive(m_Queue, pElement, ticksToWait) != pdPASS) return ks_error_queue_pop;
+
+            return ks_success;
+        }
+
+        //! \brief Dequeues element from the queue from an interrupt.
+        //!
+        //! \param pElement pointer to the element
+        //! \param higherPriorityTaskWoken set to pdTRUE if a task should be switched to when the interrupt exits
+        //! \return ks_error_queue_pop if the queue is empty
+        KsResult PopFromISR(T* pElement, BaseType_t* higherPriorityTaskWoken) {
+            if(xQueueReceiveFromISR(m_Queue, pElement, higherPriorityTaskWoken) != pdPASS) return ks_error_queue_pop;
+
+            return ks_success;
+        }
+
         //! \brief Function to Check if the element exists
         //!
         //! \param pElement pointer to the element
@@ -78,10 +156,19 @@ namespace kronos {
             return Length() - uxQueueSpacesAvailable(m_Queue);
         }
 
+        //! \brief Getter for the number of elements in the queue, from an interrupt.
+        [[nodiscard]] size_t SizeFromISR() const {
+            return uxQueueMessagesWaitingFromISR(m_Queue);
+        }
+
     private:
         //! Length of the Queue.
         const size_t m_Length;
         //! Queue Data structure.
         QueueHandle_t m_Queue;
+#if KS_STATIC_ALLOCATION
+        //! Control block of the queue
+        StaticQueue_t m_Control{};
+#endif
     };
 }
\ No newline at end of file
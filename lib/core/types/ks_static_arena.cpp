@@ -0,0 +1,65 @@
+#include "ks_static_arena.h"
+
+#if KS_STATIC_ALLOCATION && !configSUPPORT_STATIC_ALLOCATION
+#error "KS_STATIC_ALLOCATION requires configSUPPORT_STATIC_ALLOCATION to be set in FreeRTOSConfig.h"
+#endif
+
+namespace kronos {
+
+#if KS_STATIC_ALLOCATION
+    alignas(StaticArena::s_Alignment) static uint8_t s_Arena[KS_STATIC_ARENA_SIZE];
+#endif
+    static std::atomic<size_t> s_Used{ 0 };
+
+    void* StaticArena::Allocate(size_t size) {
+#if KS_STATIC_ALLOCATION
+        size = (size + s_Alignment - 1) & ~(s_Alignment - 1);
+
+        size_t used = s_Used.load(std::memory_order_relaxed);
+        do {
+            if (size > KS_STATIC_ARENA_SIZE - used) return nullptr;
+        } while (!s_Used.compare_exchange_weak(used, used + size, std::memory_order_relaxed));
+
+        return &s_Arena[used];
+#else
+        return nullptr;
+#endif
+    }
+
+    size_t StaticArena::GetUsed() {
+        return s_Used.load(std::memory_order_relaxed);
+    }
+
+}
+
+#if KS_STATIC_ALLOCATION
+// With static allocation enabled, the kernel asks the application for the memory of the tasks it creates itself
+
+extern "C" void vApplicationGetIdleTaskMemory(
+    StaticTask_t** idleTaskTCBBuffer,
+    StackType_t** idleTaskStackBuffer,
+    uint32_t* idleTaskStackSize
+) {
+    static StaticTask_t s_IdleTask;
+    static StackType_t s_IdleStack[configMINIMAL_STACK_SIZE];
+
+    *idleTaskTCBBuffer = &s_IdleTask;
+    *idleTaskStackBuffer = s_IdleStack;
+    *idleTaskStackSize = configMINIMAL_STACK_SIZE;
+}
+
+#if configUSE_TIMERS
+extern "C" void vApplicationGetTimerTaskMemory(
+    StaticTask_t** timerTaskTCBBuffer,
+    StackType_t** timerTaskStackBuffer,
+    uint32_t* timerTaskStackSize
+) {
+    static StaticTask_t s_TimerTask;
+    static StackType_t s_TimerStack[configTIMER_TASK_STACK_DEPTH];
+
+    *timerTaskTCBBuffer = &s_TimerTask;
+    *timerTaskStackBuffer = s_TimerStack;
+    *timerTaskStackSize = configTIMER_TASK_STACK_DEPTH;
+}
+#endif
+#endif
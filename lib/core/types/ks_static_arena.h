@@ -0,0 +1,53 @@
+#pragma once
+
+namespace kronos {
+
+    //! \struct MemoryBudget
+    //! \brief Memory reserved for the kernel objects of a component, see ComponentBase::GetMemoryBudget().
+    struct MemoryBudget {
+        //! Bytes of task stack
+        size_t stack = 0;
+        //! Bytes of queue storage
+        size_t queues = 0;
+        //! Bytes of task, queue, semaphore and timer control blocks
+        size_t control = 0;
+
+        [[nodiscard]] size_t GetTotal() const {
+            return stack + queues + control;
+        }
+
+        MemoryBudget& operator+=(const MemoryBudget& other) {
+            stack += other.stack;
+            queues += other.queues;
+            control += other.control;
+            return *this;
+        }
+    };
+
+    //! \class StaticArena
+    //! \brief Storage reserved at compile time for the task stacks and queues created in static allocation mode.
+    //!
+    //! Allocations only move forward and are never given back, which suits kernel objects created once while
+    //! the framework starts. Running out of room fails that startup step with ks_error_static_arena_exhausted
+    //! instead of leaving the heap half used. The arena only has storage when KS_STATIC_ALLOCATION is enabled.
+    class StaticArena {
+    public:
+        //! \brief Reserves storage from the arena.
+        //!
+        //! \param size The number of bytes, rounded up to keep every allocation aligned.
+        //! \return The storage, nullptr if the arena is exhausted.
+        static void* Allocate(size_t size);
+
+        //! \brief Getter for the number of bytes reserved so far.
+        static size_t GetUsed();
+
+        //! \brief Getter for the size of the arena.
+        static constexpr size_t GetCapacity() {
+            return KS_STATIC_ALLOCATION ? KS_STATIC_ARENA_SIZE : 0;
+        }
+
+        //! Alignment of every allocation, enough for stacks and any queued type
+        static constexpr size_t s_Alignment = 8;
+    };
+
+}
@@ -11,6 +11,8 @@ typedef uint32_t KsTickType;
 typedef uint32_t KsIdType;
 
 #include <memory>
+#include <atomic>
+#include <utility>
 #include <algorithm>
 #include <variant>
 #include <type_traits>
@@ -30,6 +32,7 @@ typedef uint32_t KsIdType;
 #include <regex>
 #include <any>
 #include <span>
+#include <coroutine>
 #include <sstream>
 
 #include "nameof.hpp"
@@ -75,6 +78,22 @@ namespace kronos {
         return typeid(T).hash_code();
     }
 
+    //! \brief Computes the 32-bit FNV-1a hash of a string at compile time.
+    constexpr KsIdType HashID(StringView str) {
+        KsIdType hash = 2166136261u;
+        for (char c: str) {
+            hash ^= static_cast<uint8_t>(c);
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
+    //! \brief Compile-time identifier of a type, usable without RTTI.
+    template<typename T>
+    constexpr KsIdType TypeID() {
+        return HashID(NAMEOF_TYPE(T));
+    }
+
     template<typename T>
     TypeInfo GetTypeInfo() {
         return {
@@ -6,7 +6,14 @@ namespace kronos {
     Scope<StackTrace>StackTrace::s_Instance;
 
     StackTrace::StackTrace(size_t length) {
+#if KS_STATIC_ALLOCATION
+        auto* storage = static_cast<uint8_t*>(StaticArena::Allocate(length * sizeof(ErrorInfo)));
+        if(storage == nullptr) KS_PANIC("Failed to allocate the stack trace");
+
+        m_Queue = xQueueCreateStatic(length, sizeof(ErrorInfo), storage, &m_Control);
+#else
         m_Queue = xQueueCreate(length, sizeof(ErrorInfo));
+#endif
         if(m_Queue == 0) KS_PANIC("Failed to create the stack trace");
     }
 
@@ -5,6 +5,7 @@
 #include "queue.h"
 
 #include "ks_error_codes.h"
+#include "ks_conf.h"
 #include "ks_pch.h"
 
 #define KS_THROW(error)                                             \
@@ -65,5 +66,9 @@ namespace kronos {
     private:
         static Scope<StackTrace> s_Instance;
         QueueHandle_t m_Queue;
+#if KS_STATIC_ALLOCATION
+        //! Control block of m_Queue
+        StaticQueue_t m_Control{};
+#endif
     };
 }
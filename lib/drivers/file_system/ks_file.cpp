@@ -16,6 +16,7 @@ namespace kronos {
     }
 
     KsResult File::Sync() {
+        FileSystem::Lock lock;
         auto ret = lfs_file_sync(FileSystem::FS(), &m_FileHandle);
         if (ret < 0) KS_THROW(ks_error_file_sync);
 
@@ -23,6 +24,7 @@ namespace kronos {
     }
 
     int32_t File::Read(void* buffer, uint32_t length) {
+        FileSystem::Lock lock;
         auto ret = lfs_file_read(FileSystem::FS(), &m_FileHandle, buffer, length);
         if (ret < 0) KS_THROW(ks_error_file_read);
 
@@ -30,6 +32,7 @@ namespace kronos {
     }
 
     int32_t File::Write(const void* buffer, uint32_t length) {
+        FileSystem::Lock lock;
         auto ret = lfs_file_write(FileSystem::FS(), &m_FileHandle, buffer, length);
         if (ret < 0) KS_THROW(ks_error_file_write);
 
@@ -37,6 +40,7 @@ namespace kronos {
     }
 
     int32_t File::Seek(int32_t offset, int seekOrigin) {
+        FileSystem::Lock lock;
         auto ret = lfs_file_seek(FileSystem::FS(), &m_FileHandle, offset, seekOrigin);
         if(ret < 0) KS_THROW(ks_error_file_seek);
 
@@ -44,6 +48,7 @@ namespace kronos {
     }
 
     KsResult File::Remove(const String& name) {
+        FileSystem::Lock lock;
         auto ret = lfs_remove(FileSystem::FS(), name.c_str());
         if (ret < 0) KS_THROW(ks_error_file_remove);
 
@@ -51,6 +56,7 @@ namespace kronos {
     }
 
     KsResult File::Open(const String& path, int flags) {
+        FileSystem::Lock lock;
         auto res = lfs_file_open(FileSystem::FS(), &m_FileHandle, path.c_str(), flags);
         if(res < 0) KS_THROW(ks_error_file_open);
 
@@ -58,6 +64,7 @@ namespace kronos {
     }
 
     KsResult File::Close() {
+        FileSystem::Lock lock;
         auto ret = lfs_file_close(FileSystem::FS(), &m_FileHandle);
         if(ret < 0) KS_THROW(ks_error_file_close);
 
@@ -65,6 +72,7 @@ namespace kronos {
     }
 
     size_t File::Size() {
+        FileSystem::Lock lock;
         auto ret = lfs_file_size(FileSystem::FS(), &m_FileHandle);
         if (ret < 0) KS_THROW(ks_error_file_size);
 
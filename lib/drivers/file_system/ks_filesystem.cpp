@@ -3,7 +3,17 @@
 namespace kronos {
     KS_SINGLETON_INSTANCE(FileSystem);
 
+    FileSystem::FileSystem() {
+#if KS_STATIC_ALLOCATION
+        m_Mutex = xSemaphoreCreateRecursiveMutexStatic(&m_MutexControl);
+#else
+        m_Mutex = xSemaphoreCreateRecursiveMutex();
+#endif
+        KS_ASSERT(m_Mutex != nullptr, "File system lock could not be created")
+    }
+
     KsResult FileSystem::_Init() {
+        Lock lock;
         auto res = _Mount();
 
         if (res != ks_success) {
@@ -16,6 +26,7 @@ namespace kronos {
     }
 
     KsResult FileSystem::_Mount() {
+        Lock lock;
         int err = lfs_mount(m_FS.get(), &cfg);
 
         if(err) KS_THROW(ks_error_filesystem_format);
@@ -24,6 +35,7 @@ namespace kronos {
     }
 
     KsResult FileSystem::_Format() {
+        Lock lock;
         int err = lfs_format(m_FS.get(), &cfg);
 
         if(err) KS_THROW(ks_error_filesystem_format);
@@ -35,6 +47,7 @@ namespace kronos {
         List<FileInfo> fileList;
         lfs_dir_t dir;
         lfs_info entry{};
+        Lock lock;
 
         // Open the root directory
         int result = lfs_dir_open(m_FS.get(), &dir, directory.c_str());
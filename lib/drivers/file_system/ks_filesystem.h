@@ -13,9 +13,30 @@ namespace kronos {
         KS_SINGLETON(FileSystem);
 
     public:
-        FileSystem() = default;
+        FileSystem();
         ~FileSystem() = default;
 
+        //! \class Lock
+        //! \brief Serializes the calls into littlefs, which is built without its own lock callbacks.
+        //!
+        //! Components are initialized in parallel at boot, every lfs_* call must be made while holding this lock.
+        class Lock {
+        public:
+            Lock() : m_Mutex(s_Instance->m_Mutex) {
+                xSemaphoreTakeRecursive(m_Mutex, portMAX_DELAY);
+            }
+
+            ~Lock() {
+                xSemaphoreGiveRecursive(m_Mutex);
+            }
+
+            Lock(const Lock& other) = delete;
+            void operator=(const Lock& other) = delete;
+
+        private:
+            SemaphoreHandle_t m_Mutex;
+        };
+
     public:
         KS_SINGLETON_EXPOSE_METHOD(_Init, KsResult Init());
         KS_SINGLETON_EXPOSE_METHOD(_Mount, KsResult Mount());
@@ -32,5 +53,10 @@ namespace kronos {
         lfs_t* _FS();
 
         Ref<lfs_t> m_FS;
+        //! Taken by Lock around every call into littlefs
+        SemaphoreHandle_t m_Mutex;
+#if KS_STATIC_ALLOCATION
+        StaticSemaphore_t m_MutexControl;
+#endif
     };
 }
\ No newline at end of file
@@ -2,6 +2,13 @@
 
 namespace kronos {
 
+    //! \struct IoVector
+    //! \brief A buffer written as one part of a WriteVector() call.
+    struct IoVector {
+        const uint8_t* data;
+        size_t length;
+    };
+
     class IoDescriptor {
 
     public:
@@ -11,6 +18,22 @@ namespace kronos {
         virtual int32_t Write(const uint8_t* buf, size_t length) = 0;
         virtual int32_t Write(const String& buf) = 0;
 
+        //! \brief Writes several buffers back to back without gathering them in a single buffer first.
+        //!
+        //! Writes the buffers one after the other, drivers able to chain transfers can override it.
+        //!
+        //! \return The number of bytes written, or the error of the first write that failed.
+        virtual int32_t WriteVector(std::span<const IoVector> vectors) {
+            int32_t written = 0;
+            for (const auto& vector: vectors) {
+                int32_t result = Write(vector.data, vector.length);
+                if (result < 0) return result;
+                written += result;
+            }
+
+            return written;
+        }
+
         virtual int32_t Read(uint8_t* buf, size_t length) = 0;
         virtual int32_t ReadUntil(uint8_t* buf, size_t length, const uint8_t* delim, size_t delimLength) = 0;
 
@@ -8,9 +8,16 @@ namespace kronos {
     static uint8_t ramBuffer[RAM_BUFFER_SIZE] = {0};
 
     static SemaphoreHandle_t ram_mutex;
+#if KS_STATIC_ALLOCATION
+    static StaticSemaphore_t ram_mutex_control;
+#endif
 
     KsResult setup() {
+#if KS_STATIC_ALLOCATION
+        ram_mutex = xSemaphoreCreateMutexStatic(&ram_mutex_control);
+#else
         ram_mutex = xSemaphoreCreateMutex();
+#endif
         if (ram_mutex == nullptr) KS_THROW(ks_error);
 
         return ks_success;
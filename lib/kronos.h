@@ -8,6 +8,7 @@
 
 // Framework
 #include "ks_bus.h"
+#include "ks_typed_bus.h"
 #include "ks_framework.h"
 
 // Drivers
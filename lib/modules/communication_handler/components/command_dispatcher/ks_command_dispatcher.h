@@ -1,10 +1,13 @@
 #pragma once
 
 #include "ks_component_active.h"
-#include "ks_bus.h"
+#include "ks_typed_bus.h"
 #include "ks_packet.h"
 
 namespace kronos {
+    //! Bus carrying the uplinked packets to dispatch
+    using CommandDispatchBus = TypedBus<Packet, ks_event_comms_dispatch>;
+
     class CommandDispatcher : public ComponentActive {
     public:
         explicit CommandDispatcher(const String& name);
@@ -13,5 +16,11 @@ namespace kronos {
 
     private:
         KsResult ProcessCommand(const Packet& packet);
+
+    private:
+        BusHandle<CommandDispatchBus> m_DispatchBus{ KS_BUS_CMD_DISPATCH };
+        BusHandle<> m_LoggerBus{ KS_BUS_LOGGER };
+        BusHandle<> m_FileManagerBus{ KS_BUS_FILE_MANAGER };
+        BusHandle<> m_TelemetryBus{ KS_BUS_TLM_LOGGER };
     };
 }
\ No newline at end of file
@@ -1,7 +1,8 @@
 #include "ks_command_listener.h"
 #include "ks_framework.h"
 #include "ks_packet_parser.h"
-#include "ks_bus.h"
+#include "ks_command_dispatcher.h"
+#include "ks_command_transmitter.h"
 
 namespace kronos {
 
@@ -33,10 +34,13 @@ namespace kronos {
 
         Packet returnPacket{};
         EncodePacket(returnPacket, packet.Header.PacketId, PacketFlags::ack, packet.Header.CommandId, nullptr, 0);
-        Bus* bus = Framework::GetBus(KS_BUS_CMD_TRANSMIT);
-        bus->Publish(returnPacket, ks_event_comms_transmit);
-
-        Framework::GetBus(KS_BUS_CMD_DISPATCH)->Publish(packet, ks_event_comms_dispatch);
+        // Acknowledgements overtake any bulk downlink already waiting to be transmitted
+        m_TransmitBus->Publish<ks_event_comms_transmit>(
+            returnPacket,
+            nullptr,
+            ks_event_priority_high
+        );
+        m_DispatchBus->Publish<ks_event_comms_dispatch>(packet);
 
         return ks_success;
     }
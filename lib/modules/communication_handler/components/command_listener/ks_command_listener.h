@@ -2,6 +2,8 @@
 
 #include "ks_component_active.h"
 #include "ks_io.h"
+#include "ks_command_dispatcher.h"
+#include "ks_command_transmitter.h"
 
 namespace kronos {
 
@@ -14,6 +16,8 @@ namespace kronos {
 
     private:
         IoDescriptor* m_IoDriver;
+        BusHandle<CommandTransmitBus> m_TransmitBus{ KS_BUS_CMD_TRANSMIT };
+        BusHandle<CommandDispatchBus> m_DispatchBus{ KS_BUS_CMD_DISPATCH };
 
         KsResult Listen();
     };
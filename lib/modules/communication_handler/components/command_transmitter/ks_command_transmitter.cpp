@@ -4,11 +4,12 @@
 namespace kronos {
 
     CommandTransmitter::CommandTransmitter(const std::string& name, IoDescriptor* ioDriver) :
-        ComponentQueued(name), m_IoDriver(ioDriver) {
+        ComponentQueued(name, 0, KS_QUEUE_TRANSMITTER_SIZE), m_IoDriver(ioDriver) {
     }
 
     KsResult CommandTransmitter::Init() {
-        Framework::GetBus(KS_BUS_CMD_TRANSMIT)->AddReceivingComponent(this);
+        KS_TRY(ks_error_component_initialize, ComponentQueued::Init());
+        s_TransmitBus->AddReceivingComponent(this);
 
         return ks_success;
     }
@@ -16,25 +17,58 @@ namespace kronos {
     KsResult CommandTransmitter::ProcessEvent(const EventMessage& message) {
         switch (message.eventCode) {
             case ks_event_comms_transmit:
-                auto packet = message.Cast<Packet>();
-                Transmit(packet);
+                Transmit(CommandTransmitBus::Read(message));
                 break;
         }
 
         return ks_success;
     }
 
+    KsResult CommandTransmitter::ProcessEvents(std::span<const EventMessage* const> messages) {
+        // The packets of the batch are written straight from their loaned buffers, which stay alive until the batch
+        // is released, so the driver sees a single write and no packet is copied
+        IoVector packets[KS_EVENT_BATCH_SIZE];
+        size_t packetCount{ 0 };
+
+        for (auto message: messages) {
+            if (message->eventCode != ks_event_comms_transmit) {
+                ProcessEvent(*message);
+                continue;
+            }
+
+            const Packet& packet = CommandTransmitBus::Read(*message);
+            packets[packetCount++] = { (const uint8_t*)&packet, sizeof(packet.Header) + packet.Header.PayloadSize };
+        }
+
+        if (packetCount > 0) m_IoDriver->WriteVector({ packets, packetCount });
+        return ks_success;
+    }
+
     KsResult CommandTransmitter::Transmit(const Packet& packet) {
         m_IoDriver->Write((uint8_t*)&packet, sizeof(packet.Header) + packet.Header.PayloadSize);
         return ks_success;
     }
 
-    KsResult CommandTransmitter::TransmitPayload(KsCommand cmd, const uint8_t* payload, size_t payloadSize, bool setEOF) {
-        Bus* transmitBus = Framework::GetBus(KS_BUS_CMD_TRANSMIT);
+    KsResult CommandTransmitter::TransmitPayload(
+        KsCommand cmd,
+        const uint8_t* payload,
+        size_t payloadSize,
+        bool setEOF,
+        KsEventPriority priority
+    ) {
+        auto* transmitBus = s_TransmitBus.Get();
+
+        // Parts are committed KS_EVENT_BATCH_SIZE at a time so the transmitter handles them in one go
+        CommandTransmitBus::Loaned packets[KS_EVENT_BATCH_SIZE];
+        size_t packetCount{ 0 };
 
         KspPacketIdxType i_packet{ 0 };
         for (size_t i = 0; i < payloadSize; i += KSP_MAX_PAYLOAD_SIZE_PART) {
-            Packet packet{};
+            // Encode straight into a buffer loaned by the bus so the packet is never copied
+            auto& packet = packets[packetCount];
+            packet = transmitBus->Loan();
+            if (!packet) KS_THROW(ks_error_bus_loan_exhausted);
+
             auto partSize = std::min<uint32_t>(
                     KSP_MAX_PAYLOAD_SIZE_PART,
                     payloadSize - i
@@ -42,12 +76,21 @@ namespace kronos {
             auto flags = (setEOF && (i + partSize) >= payloadSize) ?
                          PacketFlags::eof :
                          PacketFlags::none;
-            EncodePacketPart(packet, flags, cmd, i_packet, (uint8_t*)(payload + i), partSize);
-            KS_TRY(ks_error, transmitBus->Publish(
-                    packet,
-                    ks_event_comms_transmit
-            ));
+            EncodePacketPart(*packet, flags, cmd, i_packet, (uint8_t*)(payload + i), partSize);
             i_packet++;
+
+            if (++packetCount == KS_EVENT_BATCH_SIZE) {
+                KS_TRY(ks_error, transmitBus->CommitBatch<ks_event_comms_transmit>(packets, nullptr, priority));
+                packetCount = 0;
+            }
+        }
+
+        if (packetCount > 0) {
+            KS_TRY(ks_error, transmitBus->CommitBatch<ks_event_comms_transmit>(
+                { packets, packetCount },
+                nullptr,
+                priority
+            ));
         }
 
         return ks_success;
@@ -4,20 +4,34 @@
 #include "ks_command_ids.h"
 #include "ks_packet_parser.h"
 #include "drivers/protocols/ks_io.h"
-#include "ks_bus.h"
+#include "ks_typed_bus.h"
 
 namespace kronos {
+    //! Bus carrying the packets to downlink
+    using CommandTransmitBus = TypedBus<Packet, ks_event_comms_transmit>;
+
     class CommandTransmitter : public ComponentQueued {
     public:
         explicit CommandTransmitter(const std::string& name, IoDescriptor* ioDriver);
         KsResult Init() override;
         KsResult ProcessEvent(const EventMessage& message) override;
+        KsResult ProcessEvents(std::span<const EventMessage* const> messages) override;
 
-        static KsResult TransmitPayload(KsCommand cmd, const uint8_t* payload, size_t payloadSize, bool setEOF = true);
+        static KsResult TransmitPayload(
+            KsCommand cmd,
+            const uint8_t* payload,
+            size_t payloadSize,
+            bool setEOF = true,
+            KsEventPriority priority = ks_event_priority_low
+        );
 
     private:
         IoDescriptor* m_IoDriver;
 
         KsResult Transmit(const Packet& packet);
+
+    private:
+        //! The bus carrying the packets to downlink, resolved once for every call to TransmitPayload()
+        static inline BusHandle<CommandTransmitBus> s_TransmitBus{ KS_BUS_CMD_TRANSMIT };
     };
 }
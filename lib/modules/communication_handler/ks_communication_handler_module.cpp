@@ -10,8 +10,8 @@ namespace kronos {
 
     KsResult CommunicationHandlerModule::Init() const {
         // Busses
-        Framework::CreateBus(KS_BUS_CMD_DISPATCH);
-        Framework::CreateBus(KS_BUS_CMD_TRANSMIT);
+        Framework::CreateBus<CommandDispatchBus>(KS_BUS_CMD_DISPATCH);
+        Framework::CreateBus<CommandTransmitBus>(KS_BUS_CMD_TRANSMIT);
 
         // Drivers
         auto* driver = Framework::GetDescriptor(KS_DESC_UART_COMMS);
@@ -25,7 +25,8 @@ namespace kronos {
             KS_COMPONENT_CMD_TRANSMITTER, driver
         );
 
-        KS_TRY(ks_error, WorkerManager::RegisterComponent(ks_worker_main, commandTransmitter));
+        // Serviced by its own pool so that slow flash writes on the main workers never delay transmission
+        KS_TRY(ks_error, WorkerManager::RegisterComponent(ks_worker_high, commandTransmitter));
 
         return ks_success;
     }
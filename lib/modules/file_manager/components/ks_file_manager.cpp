@@ -12,8 +12,7 @@ namespace kronos {
     FileManager::FileManager() :ComponentQueued(KS_COMPONENT_FILE_MANAGER){}
 
     KsResult FileManager::Init() {
-        auto bus = Framework::GetBus(KS_BUS_FILE_MANAGER);
-        KS_TRY(ks_error_component_initialize, bus->AddReceivingComponent(this));
+        KS_TRY(ks_error_component_initialize, m_FileManagerBus->AddReceivingComponent(this));
 
         return ks_success;
     }
@@ -38,7 +37,7 @@ namespace kronos {
     }
 
     KsResult FileManager::DownlinkBegin(const String& fileName) {
-        Bus* transmitBus = Framework::GetBus(KS_BUS_CMD_TRANSMIT);
+        auto* transmitBus = m_TransmitBus.Get();
 
         KS_TRY(ks_error, m_File.Open(fileName, KS_OPEN_MODE_READ_ONLY));
 
@@ -46,7 +45,9 @@ namespace kronos {
         m_BytesSent = 0;
 
         // Build first packet with file info
-        Packet packet{};
+        auto packet = transmitBus->Loan();
+        if (!packet) KS_THROW(ks_error_bus_loan_exhausted);
+
         size_t totalSize = sizeof(m_FileSize);
         totalSize += fileName.size() + 1;
         uint8_t buffer[totalSize];
@@ -55,11 +56,12 @@ namespace kronos {
         memcpy(buffer, &m_FileSize, sizeof(m_FileSize));
         memcpy(buffer + sizeof(m_FileSize), fileName.c_str(), fileName.size() + 1);
 
-        EncodePacket(packet, PacketFlags::none, KS_CMD_RES_FILEINFO, buffer, totalSize);
+        EncodePacket(*packet, PacketFlags::none, KS_CMD_RES_FILEINFO, buffer, totalSize);
 
-        KS_TRY(ks_error, transmitBus->Publish(
-            packet,
-            ks_event_comms_transmit
+        KS_TRY(ks_error, transmitBus->Commit<ks_event_comms_transmit>(
+            std::move(packet),
+            nullptr,
+            ks_event_priority_low
         ));
 
         KS_TRY(ks_error, DownlinkNext());
@@ -86,25 +88,44 @@ namespace kronos {
     }
 
     KsResult FileManager::DownlinkFetch(const FileFetch& fetchRequest) {
-        Bus* transmitBus = Framework::GetBus(KS_BUS_CMD_TRANSMIT);
+        auto* transmitBus = m_TransmitBus.Get();
 
         KS_TRY(ks_error, m_File.Seek(fetchRequest.offset, KS_SEEK_SET));
         m_DownlinkBufferSize = m_File.Read(m_DownlinkBuffer, KSP_MAX_PAYLOAD_SIZE_PART * KSP_MAX_PACKET_PART_RATE);
 
         if(m_DownlinkBufferSize < 0) KS_THROW(ks_error);
 
+        CommandTransmitBus::Loaned packets[KS_EVENT_BATCH_SIZE];
+        size_t packetCount{ 0 };
+
         for (const auto& i_Packet: fetchRequest.packets) {
-            Packet packet{};
+            // The file part is copied once, from the read buffer into the loaned packet the UART writes from
+            auto& packet = packets[packetCount];
+            packet = transmitBus->Loan();
+            if (!packet) KS_THROW(ks_error_bus_loan_exhausted);
+
             auto offset = i_Packet * KSP_MAX_PAYLOAD_SIZE_PART;
             // we use uint32_t bc otherwise m_DownlinkBufferSize - offset might overflow and this won't work
             auto payloadSize = std::min<uint32_t>(KSP_MAX_PAYLOAD_SIZE_PART, m_DownlinkBufferSize - offset);
             auto flags = PacketFlags::none;
 
-            EncodePacketPart(packet, flags, KS_CMD_RES_FILEPART, i_Packet, m_DownlinkBuffer + offset, payloadSize);
+            EncodePacketPart(*packet, flags, KS_CMD_RES_FILEPART, i_Packet, m_DownlinkBuffer + offset, payloadSize);
+
+            if (++packetCount == KS_EVENT_BATCH_SIZE) {
+                KS_TRY(ks_error, transmitBus->CommitBatch<ks_event_comms_transmit>(
+                    packets,
+                    nullptr,
+                    ks_event_priority_low
+                ));
+                packetCount = 0;
+            }
+        }
 
-            KS_TRY(ks_error, transmitBus->Publish(
-                packet,
-                ks_event_comms_transmit
+        if (packetCount > 0) {
+            KS_TRY(ks_error, transmitBus->CommitBatch<ks_event_comms_transmit>(
+                { packets, packetCount },
+                nullptr,
+                ks_event_priority_low
             ));
         }
 
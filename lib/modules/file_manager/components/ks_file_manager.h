@@ -3,6 +3,7 @@
 #include "ks_file.h"
 #include "ks_component_queued.h"
 #include "ks_packet_parser.h"
+#include "ks_command_transmitter.h"
 
 #define KS_DOWNLINK_FILE_RATE 10
 
@@ -34,5 +35,8 @@ namespace kronos {
         uint64_t m_BytesSent{0};
         uint64_t m_FileSize{0};
         File m_File;
+
+        BusHandle<> m_FileManagerBus{ KS_BUS_FILE_MANAGER };
+        BusHandle<CommandTransmitBus> m_TransmitBus{ KS_BUS_CMD_TRANSMIT };
     };
 }
\ No newline at end of file
@@ -20,24 +20,12 @@ namespace kronos {
     }
 
     KsResult HouseKeeping::PostInit() {
-        auto list = Framework::GetInstance().m_ActiveComponents;
-
-        std::erase_if(list, [](const String& name){
-            return name == KS_COMPONENT_HOUSEKEEPING;
+        Framework::GetInstance()._ForEachComponent([this](ComponentBase* component) {
+            auto* componentActive = dynamic_cast<ComponentActive*>(component);
+            if (componentActive != nullptr && componentActive != this)
+                m_ActiveComponentInfos[componentActive] = {};
         });
 
-        std::transform(
-            list.begin(),
-            list.end(),
-            std::inserter(m_ActiveComponentInfos, m_ActiveComponentInfos.end()),
-            [](const String& name) {
-                return std::pair<ComponentActive*, ComponentHealthInfo>{
-                    dynamic_cast<ComponentActive*>(Framework::GetInstance().m_Components[name].get()),
-                    {}
-                };
-            }
-        );
-
         for (const auto& [componentActive, healthInfo]: m_ActiveComponentInfos) {
             KS_TRY(ks_error, m_BusPing->AddReceivingComponent(componentActive));
         }
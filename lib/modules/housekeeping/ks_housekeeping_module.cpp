@@ -8,8 +8,8 @@ namespace kronos {
 
     KsResult HouseKeepingModule::Init() const {
         // Create Busses
-        Framework::CreateBus(KS_BUS_HEALTH_PING);
-        Framework::CreateBus(KS_BUS_HEALTH_PONG);
+        Framework::CreateBus(KS_BUS_HEALTH_PING, ks_event_priority_high);
+        Framework::CreateBus(KS_BUS_HEALTH_PONG, ks_event_priority_high);
 
         // Create Components
         Framework::CreateSingletonComponent<HouseKeeping>();
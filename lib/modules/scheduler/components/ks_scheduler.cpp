@@ -3,11 +3,75 @@
 
 namespace kronos {
 
+    // Identifiers hold the index of the schedule in their low half and its generation in their high half
+    static_assert(KS_SCHEDULER_CAPACITY > 0 && KS_SCHEDULER_CAPACITY <= UINT16_MAX,
+                  "Scheduler capacity must fit in a 16-bit index!");
+
     KS_SINGLETON_INSTANCE(Scheduler);
 
-    Scheduler::Scheduler() : ComponentPassive(KS_COMPONENT_SCHEDULER) {}
+    Scheduler::Scheduler() : ComponentPassive(KS_COMPONENT_SCHEDULER) {
+        for (size_t i = KS_SCHEDULER_CAPACITY; i-- > 0;) {
+            m_Events[i].next = m_Free;
+            m_Free = &m_Events[i];
+        }
+
+        // Created here rather than in Init() because components schedule their events before the scheduler starts
+#if KS_STATIC_ALLOCATION
+        m_Lock = xSemaphoreCreateMutexStatic(&m_LockControl);
+#else
+        m_Lock = xSemaphoreCreateMutex();
+#endif
+        KS_ASSERT(m_Lock != nullptr, "Scheduler lock could not be created")
+
+        // Events are delivered with m_Lock held, so the task must never wait on a busy subscriber and hold up the
+        // callers of the API. A subscriber that falls behind gets a single event per code and can read how many it
+        // missed instead.
+        for (auto& subscription: m_Subscriptions) {
+            subscription.overflow = ks_overflow_coalesce;
+            subscription.timeout = 0;
+        }
+    }
 
     KsResult Scheduler::Init() {
+#if KS_STATIC_ALLOCATION
+        auto* stack = static_cast<StackType_t*>(StaticArena::Allocate(KS_SCHEDULER_TASK_STACK_SIZE * sizeof(StackType_t)));
+        if (stack == nullptr) KS_THROW(ks_error_static_arena_exhausted);
+
+        m_Task = xTaskCreateStatic(
+            Start,
+            "SCHEDULER",
+            KS_SCHEDULER_TASK_STACK_SIZE,
+            this,
+            KS_SCHEDULER_TASK_PRIORITY,
+            stack,
+            &m_TaskControl
+        );
+        if (m_Task == nullptr) KS_THROW(ks_error_component_task_create);
+#else
+        if (xTaskCreate(
+            Start,
+            "SCHEDULER",
+            KS_SCHEDULER_TASK_STACK_SIZE,
+            this,
+            KS_SCHEDULER_TASK_PRIORITY,
+            &m_Task
+        ) != pdPASS) {
+            KS_THROW(ks_error_component_task_create);
+        }
+#endif
+
+        m_Epoch = xTaskGetTickCount();
+
+#if KS_STATIC_ALLOCATION
+        m_Timer = xTimerCreateStatic(
+            "SCHEDULER",
+            pdMS_TO_TICKS(KS_DEFAULT_TIMER_INTERVAL),
+            pdTRUE,
+            this,
+            TickStub,
+            &m_TimerControl
+        );
+#else
         m_Timer = xTimerCreate(
             "SCHEDULER",
             pdMS_TO_TICKS(KS_DEFAULT_TIMER_INTERVAL),
@@ -15,6 +79,7 @@ namespace kronos {
             this,
             TickStub
         );
+#endif
 
         if(m_Timer == NULL) KS_THROW(ks_error);
         if(xTimerStart(m_Timer, 0) != pdPASS) KS_THROW(ks_error);
@@ -22,41 +87,328 @@ namespace kronos {
         return ks_success;
     }
 
+    KsResult Scheduler::Destroy() {
+        if (m_Timer != nullptr) {
+            // The timer task runs above the components, so it handles the commands before xTimerStop returns
+            if (xTimerStop(m_Timer, portMAX_DELAY) != pdPASS) KS_THROW(ks_error);
+            if (xTimerDelete(m_Timer, portMAX_DELAY) != pdPASS) KS_THROW(ks_error);
+            m_Timer = nullptr;
+        }
+
+        // Cleared before the task is deleted so that a tick already running in the timer task skips the notification
+        TaskHandle_t task = std::exchange(m_Task, nullptr);
+        if (task != nullptr) vTaskDelete(task);
+
+        return ComponentPassive::Destroy();
+    }
+
+    MemoryBudget Scheduler::GetMemoryBudget() const {
+        return {
+            .stack = KS_SCHEDULER_TASK_STACK_SIZE * sizeof(StackType_t),
+            .control = sizeof(StaticTimer_t) + sizeof(StaticTask_t) + sizeof(StaticSemaphore_t)
+        };
+    }
+
     Scheduler::~Scheduler() {
-        xTimerDelete(m_Timer, 0);
+        Destroy();
+        if (m_Lock != nullptr) vSemaphoreDelete(m_Lock);
     }
 
-    KsResult Scheduler::_ScheduleEvent(uint32_t intervalMs, KsEventCodeType eventCode, ComponentQueued* component) {
-        uint32_t tickRate = intervalMs / KS_DEFAULT_TIMER_INTERVAL;
+    KsResult Scheduler::_ScheduleEvent(
+        uint32_t intervalMs,
+        KsEventCodeType eventCode,
+        ComponentQueued* component,
+        uint32_t phaseMs,
+        KsScheduleId* id
+    ) {
+        uint32_t phase = phaseMs == KS_SCHEDULE_PHASE_AUTO ? KS_SCHEDULE_PHASE_AUTO : phaseMs / KS_DEFAULT_TIMER_INTERVAL;
+        return Add(component, eventCode, ToTicks(intervalMs), phase, 0, id);
+    }
+
+    KsResult Scheduler::_ScheduleEventOnce(
+        uint32_t delayMs,
+        KsEventCodeType eventCode,
+        ComponentQueued* component,
+        KsScheduleId* id
+    ) {
+        return Add(component, eventCode, 0, 0, ToTicks(delayMs), id);
+    }
 
-        // Create the bus if it doesn't exist.
-        if (!m_ScheduledBusses.contains(tickRate)) {
-            m_ScheduledBusses[tickRate] = {
-                .bus = Framework::CreateBus("B_SCHED_" + std::to_string(intervalMs))
-            };
+    KsResult Scheduler::_Reschedule(KsScheduleId id, uint32_t intervalMs, uint32_t delayMs) {
+        xSemaphoreTake(m_Lock, portMAX_DELAY);
+        ScheduledEvent* event = Find(id);
+        if (event != nullptr) {
+            Disarm(event);
+            event->period = intervalMs == 0 ? 0 : ToTicks(intervalMs);
+            Arm(event, m_Wheel.GetNow() + ToTicks(delayMs));
         }
+        xSemaphoreGive(m_Lock);
 
-        // Insert new event code to publish.
-        m_ScheduledBusses[tickRate].eventCodes.insert(eventCode);
-        KS_TRY(ks_error, m_ScheduledBusses[tickRate].bus->AddReceivingComponent(component));
+        if (event == nullptr) KS_THROW(ks_error_scheduler_missing);
 
         return ks_success;
     }
 
+    KsResult Scheduler::_Cancel(KsScheduleId id) {
+        xSemaphoreTake(m_Lock, portMAX_DELAY);
+        ScheduledEvent* event = Find(id);
+        if (event != nullptr) {
+            Disarm(event);
+            Free(event);
+        }
+        xSemaphoreGive(m_Lock);
+
+        if (event == nullptr) KS_THROW(ks_error_scheduler_missing);
+
+        return ks_success;
+    }
+
+    const DeliveryStats* Scheduler::_GetDeliveryStats(const ComponentQueued* component) {
+        const DeliveryStats* stats = nullptr;
+
+        xSemaphoreTake(m_Lock, portMAX_DELAY);
+        for (const auto& subscription: m_Subscriptions) {
+            if (subscription.component == component) stats = &subscription.stats;
+        }
+        xSemaphoreGive(m_Lock);
+
+        return stats;
+    }
+
+    KsResult Scheduler::_GetScheduleStats(KsScheduleId id, ScheduleStats* stats) {
+        xSemaphoreTake(m_Lock, portMAX_DELAY);
+        ScheduledEvent* event = Find(id);
+        if (event != nullptr) *stats = event->stats;
+        xSemaphoreGive(m_Lock);
+
+        if (event == nullptr) KS_THROW(ks_error_scheduler_missing);
+
+        return ks_success;
+    }
+
+    size_t Scheduler::_GetScheduleCount() {
+        return m_Wheel.GetSize();
+    }
+
+    uint32_t Scheduler::_GetTickLoad(uint32_t tick) {
+        return m_Load[tick % KS_SCHEDULER_PHASE_WINDOW];
+    }
+
+    uint32_t Scheduler::_GetMaxBacklog() {
+        return m_MaxBacklog.load(std::memory_order_relaxed);
+    }
+
+    KsResult Scheduler::Add(
+        ComponentQueued* component,
+        KsEventCodeType eventCode,
+        uint32_t period,
+        uint32_t phase,
+        uint32_t delay,
+        KsScheduleId* id
+    ) {
+        if (component == nullptr) KS_THROW(ks_error);
+
+        xSemaphoreTake(m_Lock, portMAX_DELAY);
+        // A subscription is only claimed when a schedule is free, so that a failure never leaves one unused
+        const Subscription* subscription = m_Free != nullptr ? FindSubscription(component) : nullptr;
+        auto* event = static_cast<ScheduledEvent*>(subscription != nullptr ? m_Free : nullptr);
+        if (event != nullptr) {
+            m_SubscriptionUsers[subscription - m_Subscriptions]++;
+            m_Free = event->next;
+            event->next = nullptr;
+            event->component = component;
+            event->subscription = subscription;
+            event->period = period;
+            event->eventCode = eventCode;
+            event->stats = {};
+
+            if (period == 0) {
+                Arm(event, m_Wheel.GetNow() + delay);
+            } else {
+                phase = phase == KS_SCHEDULE_PHASE_AUTO ? FindPhase(period) : phase % period;
+                Arm(event, NextDeadline(period, phase));
+            }
+
+            if (id != nullptr) *id = (KsScheduleId(event->generation) << 16) | KsScheduleId(event - m_Events);
+        }
+        xSemaphoreGive(m_Lock);
+
+        if (event == nullptr) KS_THROW(ks_error_scheduler_full);
+
+        return ks_success;
+    }
+
+    void Scheduler::Arm(ScheduledEvent* event, KsTickType deadline) {
+        m_Wheel.Insert(event, deadline);
+        if (event->period == 0) return;
+
+        event->phase = event->deadline % event->period;
+        AddLoad(event->period, event->phase, 1);
+    }
+
+    void Scheduler::Disarm(ScheduledEvent* event) {
+        if (TimingWheel::Contains(event) && event->period != 0)
+            AddLoad(event->period, event->phase, -1);
+
+        m_Wheel.Remove(event);
+    }
+
+    void Scheduler::AddLoad(uint32_t period, uint32_t phase, int32_t count) {
+        // Periods longer than the window are due on a single tick of it
+        for (uint32_t tick = phase % KS_SCHEDULER_PHASE_WINDOW; tick < KS_SCHEDULER_PHASE_WINDOW; tick += period)
+            m_Load[tick] += count;
+    }
+
+    uint32_t Scheduler::FindPhase(uint32_t period) const {
+        uint32_t best = 0;
+        uint32_t bestPeak = UINT32_MAX;
+        uint32_t bestTotal = UINT32_MAX;
+
+        for (uint32_t phase = 0; phase < std::min<uint32_t>(period, KS_SCHEDULER_PHASE_WINDOW); phase++) {
+            uint32_t peak = 0;
+            uint32_t total = 0;
+            for (uint32_t tick = phase; tick < KS_SCHEDULER_PHASE_WINDOW; tick += period) {
+                peak = std::max<uint32_t>(peak, m_Load[tick]);
+                total += m_Load[tick];
+            }
+
+            if (peak < bestPeak || (peak == bestPeak && total < bestTotal)) {
+                best = phase;
+                bestPeak = peak;
+                bestTotal = total;
+            }
+        }
+
+        return best;
+    }
+
+    KsTickType Scheduler::NextDeadline(uint32_t period, uint32_t phase) const {
+        KsTickType next = m_Wheel.GetNow() + 1;
+        return next + (phase + period - next % period) % period;
+    }
+
+    ScheduledEvent* Scheduler::Find(KsScheduleId id) {
+        size_t index = id & UINT16_MAX;
+        if (index >= KS_SCHEDULER_CAPACITY) return nullptr;
+
+        ScheduledEvent* event = &m_Events[index];
+        if (event->component == nullptr || event->generation != (id >> 16)) return nullptr;
+
+        return event;
+    }
+
+    const Subscription* Scheduler::FindSubscription(ComponentQueued* component) {
+        Subscription* free = nullptr;
+        for (auto& subscription: m_Subscriptions) {
+            if (subscription.component == component) return &subscription;
+            if (subscription.component == nullptr && free == nullptr) free = &subscription;
+        }
+
+        if (free != nullptr) free->component = component;
+        return free;
+    }
+
+    void Scheduler::Free(ScheduledEvent* event) {
+        size_t index = event->subscription - m_Subscriptions;
+        if (--m_SubscriptionUsers[index] == 0) {
+            Subscription& subscription = m_Subscriptions[index];
+            subscription.component = nullptr;
+            subscription.stats.delivered.store(0, std::memory_order_relaxed);
+            subscription.stats.dropped.store(0, std::memory_order_relaxed);
+            subscription.stats.evicted.store(0, std::memory_order_relaxed);
+            subscription.stats.coalesced.store(0, std::memory_order_relaxed);
+        }
+
+        event->component = nullptr;
+        event->subscription = nullptr;
+
+        // 0 is skipped so that no identifier is ever 0
+        if (++event->generation == 0) event->generation = 1;
+
+        event->next = m_Free;
+        m_Free = event;
+    }
+
+    void Scheduler::Expire(ScheduledEvent* event, KsTickType now, uint32_t pileUp) {
+        // Timers never run early, but a difference keeps a wrapped tick count from looking very late
+        KsTickType due = m_Epoch + event->deadline * pdMS_TO_TICKS(KS_DEFAULT_TIMER_INTERVAL);
+        RecordDelivery(event->stats, std::max<int32_t>(static_cast<int32_t>(now - due), 0), pileUp);
+
+        // Periodic schedules are rearmed from their deadline rather than from now so that they keep their phase
+        if (event->period != 0) m_Wheel.Insert(event, event->deadline + event->period);
+
+        // A coalescing subscription never waits for room, which is what allows delivering with m_Lock held
+        EventMessage* message = Framework::CreateEventMessage(event->eventCode);
+        if (message == nullptr) {
+            event->subscription->stats.dropped.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            event->component->ReceiveEvent(message, *event->subscription);
+        }
+
+        // One-shot schedules are freed once delivered, which may give the subscription back
+        if (event->period == 0) Free(event);
+    }
+
+    uint32_t Scheduler::ToTicks(uint32_t ms) {
+        return std::max<uint32_t>(ms / KS_DEFAULT_TIMER_INTERVAL, 1);
+    }
+
+    void Scheduler::RecordDelivery(ScheduleStats& stats, KsTickType lateness, uint32_t pileUp) {
+        if (stats.deliveries > 0) {
+            KsTickType jitter = lateness > stats.lateness ? lateness - stats.lateness : stats.lateness - lateness;
+            stats.maxJitter = std::max(stats.maxJitter, jitter);
+            stats.totalJitter += jitter;
+        }
+
+        stats.deliveries++;
+        stats.lateness = lateness;
+        stats.maxLateness = std::max(stats.maxLateness, lateness);
+        stats.maxPileUp = std::max(stats.maxPileUp, pileUp);
+    }
+
     void Scheduler::TickStub(TimerHandle_t timerHandle) {
-        auto* timer = static_cast<Scheduler*>(pvTimerGetTimerID(timerHandle));
-        timer->Tick();
+        // Nothing else runs in the timer task, so the other software timers are never held up by the deliveries
+        auto* scheduler = static_cast<Scheduler*>(pvTimerGetTimerID(timerHandle));
+        TaskHandle_t task = scheduler->m_Task;
+        if (task != nullptr) xTaskNotifyGive(task);
+    }
+
+    void Scheduler::Start(void* data) {
+        static_cast<Scheduler*>(data)->Run();
+    }
+
+    void Scheduler::Run() {
+        while (true) {
+            // The notification value counts the ticks, those given while the task was busy are caught up on
+            uint32_t backlog = ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            if (backlog > m_MaxBacklog.load(std::memory_order_relaxed))
+                m_MaxBacklog.store(backlog, std::memory_order_relaxed);
+
+            while (backlog-- > 0)
+                Tick();
+        }
     }
 
     void Scheduler::Tick() {
-        for (auto& [tickRate, scheduledBus]: m_ScheduledBusses) {
-            scheduledBus.tickCount++;
-            if (scheduledBus.tickCount >= tickRate) {
-                scheduledBus.tickCount = 0;
-                for (const auto& eventCode: scheduledBus.eventCodes)
-                    scheduledBus.bus->Publish(eventCode);
-            }
+        KsTickType now = xTaskGetTickCount();
+
+        // Only the callers of the API wait for the deliveries, the other tasks and the timer task keep running
+        xSemaphoreTake(m_Lock, portMAX_DELAY);
+
+        // Due schedules are collected before any is delivered, so that each one knows how many share its tick
+        WheelEntry* due = nullptr;
+        auto pileUp = static_cast<uint32_t>(m_Wheel.Advance([&due](WheelEntry* entry) {
+            entry->next = due;
+            due = entry;
+        }));
+
+        while (due != nullptr) {
+            auto* event = static_cast<ScheduledEvent*>(due);
+            due = due->next;
+            Expire(event, now, pileUp);
         }
+
+        xSemaphoreGive(m_Lock);
     }
 
 }
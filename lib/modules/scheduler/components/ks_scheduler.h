@@ -2,16 +2,64 @@
 
 #include "ks_bus.h"
 #include "ks_component_worker.h"
+#include "ks_timing_wheel.h"
 
 #define KS_DEFAULT_TIMER_INTERVAL 50
+//! Phase given to a schedule so that the scheduler picks the one that piles up the fewest events on a tick
+#define KS_SCHEDULE_PHASE_AUTO UINT32_MAX
 
 namespace kronos {
-    struct ScheduledBus {
-        Bus* bus;
-        Set <KsEventCodeType> eventCodes{};
-        uint32_t tickCount = 0;
+    //! Identifier of a schedule, 0 is never used
+    typedef uint32_t KsScheduleId;
+
+    //! \struct ScheduleStats
+    //! \brief Timing of the deliveries of a schedule, in OS ticks.
+    struct ScheduleStats {
+        //! Number of events delivered
+        uint32_t deliveries = 0;
+        //! Time between the deadline and the delivery of the last event
+        KsTickType lateness = 0;
+        //! Longest time between a deadline and its delivery
+        KsTickType maxLateness = 0;
+        //! Largest change of lateness between two deliveries, which is how far an interval strayed from the period
+        KsTickType maxJitter = 0;
+        //! Sum of the change of lateness between two deliveries, divide by deliveries - 1 for the mean jitter
+        uint32_t totalJitter = 0;
+        //! Most schedules that were due on the same scheduler tick as this one, itself included
+        uint32_t maxPileUp = 0;
+    };
+
+    //! \struct ScheduledEvent
+    //! \brief An event code delivered to a component once or periodically, waiting in the timing wheel.
+    struct ScheduledEvent : WheelEntry {
+        //! The component receiving the event, nullptr if the schedule is free
+        ComponentQueued* component = nullptr;
+        //! The subscription the event is delivered through, shared by every schedule of the component
+        const Subscription* subscription = nullptr;
+        //! Scheduler ticks between two deliveries, 0 for a one-shot deadline
+        uint32_t period = 0;
+        //! Remainder of the deadlines of a periodic schedule divided by its period
+        uint32_t phase = 0;
+        ScheduleStats stats{};
+        KsEventCodeType eventCode = ks_event_invalid;
+        //! Changed every time the schedule is freed, so that identifiers of freed schedules are rejected
+        uint16_t generation = 1;
     };
 
+    //! \class Scheduler
+    //! \brief Delivers events to components at a fixed rate or once at a deadline.
+    //!
+    //! Schedules wait in a TimingWheel advanced every KS_DEFAULT_TIMER_INTERVAL ms, so a tick only costs the
+    //! schedules that are due. The timer only notifies the task of the scheduler, which advances the wheel and
+    //! delivers the events, so the timer task spends a few microseconds per tick whatever the number of schedules.
+    //! Events are delivered through one ks_overflow_coalesce subscription per component: a component that falls
+    //! behind gets a single event per code and can read how many it missed. The schedules are preallocated,
+    //! KS_SCHEDULER_CAPACITY of them, and a separate limit of KS_SCHEDULER_SUBSCRIBERS components have schedules
+    //! at the same time.
+    //!
+    //! Periodic schedules are due on the ticks whose count since the start of the scheduler is their phase modulo
+    //! their period. Rates sharing a common multiple then only fire together if their phases line up, and the
+    //! scheduler can pick the phases itself by keeping count of how many periodic events are due on every tick.
     class Scheduler : public ComponentPassive {
     KS_SINGLETON(Scheduler);
 
@@ -21,26 +69,223 @@ namespace kronos {
 
         KsResult Init() override;
 
+        //! \brief Stops the task of the scheduler.
+        KsResult Destroy() override;
+
+        //! \brief Reports the stack and control block of the task, and the control blocks of the timer and of the lock.
+        [[nodiscard]] MemoryBudget GetMemoryBudget() const override;
+
     public:
         KS_SINGLETON_EXPOSE_METHOD(_ScheduleEvent,
-                                    KsResult ScheduleEvent(
+                                   KsResult ScheduleEvent(
                                        uint32_t intervalMs,
                                        KsEventCodeType eventCode,
-                                       ComponentQueued * component
+                                       ComponentQueued * component,
+                                       uint32_t phaseMs = KS_SCHEDULE_PHASE_AUTO,
+                                       KsScheduleId * id = nullptr
                                    ),
                                    intervalMs,
                                    eventCode,
+                                   component,
+                                   phaseMs,
+                                   id);
+
+        KS_SINGLETON_EXPOSE_METHOD(_ScheduleEventOnce,
+                                   KsResult ScheduleEventOnce(
+                                       uint32_t delayMs,
+                                       KsEventCodeType eventCode,
+                                       ComponentQueued * component,
+                                       KsScheduleId * id = nullptr
+                                   ),
+                                   delayMs,
+                                   eventCode,
+                                   component,
+                                   id);
+
+        KS_SINGLETON_EXPOSE_METHOD(_Reschedule,
+                                   KsResult Reschedule(KsScheduleId id, uint32_t intervalMs, uint32_t delayMs),
+                                   id,
+                                   intervalMs,
+                                   delayMs);
+
+        KS_SINGLETON_EXPOSE_METHOD(_Cancel, KsResult Cancel(KsScheduleId id), id);
+
+        KS_SINGLETON_EXPOSE_METHOD(_GetDeliveryStats,
+                                   const DeliveryStats* GetDeliveryStats(const ComponentQueued* component),
                                    component);
 
+        KS_SINGLETON_EXPOSE_METHOD(_GetScheduleStats,
+                                   KsResult GetScheduleStats(KsScheduleId id, ScheduleStats * stats),
+                                   id,
+                                   stats);
+
+        KS_SINGLETON_EXPOSE_METHOD(_GetScheduleCount, size_t GetScheduleCount());
+
+        KS_SINGLETON_EXPOSE_METHOD(_GetTickLoad, uint32_t GetTickLoad(uint32_t tick), tick);
+
+        KS_SINGLETON_EXPOSE_METHOD(_GetMaxBacklog, uint32_t GetMaxBacklog());
+
     private:
-        KsResult _ScheduleEvent(uint32_t intervalMs, KsEventCodeType eventCode, ComponentQueued* component);
+        //! \brief Delivers an event to a component every intervalMs.
+        //!
+        //! \param intervalMs Period of the event, rounded down to a multiple of KS_DEFAULT_TIMER_INTERVAL.
+        //! \param eventCode The event code delivered.
+        //! \param component The component receiving the event.
+        //! \param phaseMs Offset of the deliveries from the start of the scheduler, modulo the period, or
+        //! KS_SCHEDULE_PHASE_AUTO to use the offset that piles up the fewest events on a tick.
+        //! \param id Set to the identifier of the schedule, used to change or cancel it. Can be nullptr.
+        //! \return ks_error_scheduler_full if every schedule or subscriber is used.
+        KsResult _ScheduleEvent(
+            uint32_t intervalMs,
+            KsEventCodeType eventCode,
+            ComponentQueued* component,
+            uint32_t phaseMs = KS_SCHEDULE_PHASE_AUTO,
+            KsScheduleId* id = nullptr
+        );
+
+        //! \brief Delivers an event to a component once, delayMs from now. One-shot events don't have a phase.
+        KsResult _ScheduleEventOnce(
+            uint32_t delayMs,
+            KsEventCodeType eventCode,
+            ComponentQueued* component,
+            KsScheduleId* id = nullptr
+        );
+
+        //! \brief Changes the period and the next deadline of a schedule, even one that is one-shot.
+        //!
+        //! \param intervalMs The new period, 0 makes the schedule one-shot.
+        //! \param delayMs Time until the next delivery, which sets the new phase of a periodic schedule.
+        //! \return ks_error_scheduler_missing if the schedule was cancelled or its deadline passed.
+        KsResult _Reschedule(KsScheduleId id, uint32_t intervalMs, uint32_t delayMs);
+
+        //! \brief Stops a schedule before its next delivery.
+        //!
+        //! \return ks_error_scheduler_missing if the schedule was cancelled or its deadline passed.
+        KsResult _Cancel(KsScheduleId id);
 
+        //! \brief Getter for the delivery counters of the events scheduled for a component.
+        //!
+        //! The counters are reset once the last schedule of the component is cancelled or expires.
+        //!
+        //! \return nullptr if the component has no schedule.
+        const DeliveryStats* _GetDeliveryStats(const ComponentQueued* component);
+
+        //! \brief Getter for the delivery timings of a schedule.
+        //!
+        //! \param stats Set to a copy of the timings.
+        //! \return ks_error_scheduler_missing if the schedule was cancelled or its deadline passed.
+        KsResult _GetScheduleStats(KsScheduleId id, ScheduleStats* stats);
+
+        //! \brief Getter for the number of schedules waiting for their next delivery.
+        size_t _GetScheduleCount();
+
+        //! \brief Getter for the number of periodic events due on a tick of the phase window.
+        //!
+        //! \param tick A scheduler tick, taken modulo KS_SCHEDULER_PHASE_WINDOW.
+        uint32_t _GetTickLoad(uint32_t tick);
+
+        //! \brief Getter for the most timer ticks that waited for the task of the scheduler at the same time.
+        //!
+        //! Anything above 1 means that delivering the events of a tick took longer than the tick, or that the task
+        //! was kept from running by tasks of higher priority.
+        uint32_t _GetMaxBacklog();
+
+        //! \brief Takes a free schedule and arms it.
+        //!
+        //! \param period Scheduler ticks between two deliveries, 0 for a one-shot deadline.
+        //! \param phase Phase of a periodic schedule in scheduler ticks, or KS_SCHEDULE_PHASE_AUTO.
+        //! \param delay Scheduler ticks until a one-shot deadline.
+        KsResult Add(
+            ComponentQueued* component,
+            KsEventCodeType eventCode,
+            uint32_t period,
+            uint32_t phase,
+            uint32_t delay,
+            KsScheduleId* id
+        );
+
+        //! \brief Arms a schedule for a deadline and counts its deliveries in the phase window if it is periodic.
+        void Arm(ScheduledEvent* event, KsTickType deadline);
+
+        //! \brief Disarms a schedule and takes its deliveries out of the phase window.
+        void Disarm(ScheduledEvent* event);
+
+        //! \brief Adds to the count of the ticks of the phase window a periodic schedule is due at.
+        void AddLoad(uint32_t period, uint32_t phase, int32_t count);
+
+        //! \brief Finds the phase of a new periodic schedule that keeps the most loaded tick lowest.
+        //!
+        //! Phases are compared on the most periodic events due on one of their ticks, then on the events due over
+        //! all of their ticks, then on their value.
+        uint32_t FindPhase(uint32_t period) const;
+
+        //! \brief Finds the first tick after the current one that is due for a phase.
+        KsTickType NextDeadline(uint32_t period, uint32_t phase) const;
+
+        //! \brief Finds the schedule an identifier was given for, m_Lock must be held.
+        ScheduledEvent* Find(KsScheduleId id);
+
+        //! \brief Finds the subscription of a component, claiming a free one if needed.
+        //!
+        //! \return nullptr if every subscription is used by another component.
+        const Subscription* FindSubscription(ComponentQueued* component);
+
+        //! \brief Gives a schedule back to the free list, m_Lock must be held.
+        //!
+        //! The subscription of the component is given back with its last schedule, so that a component destroyed
+        //! after cancelling its schedules doesn't keep a subscription or pass its counters on to another one.
+        void Free(ScheduledEvent* event);
+
+        //! \brief Delivers the event of a due schedule and rearms it or frees it.
+        //!
+        //! \param now The OS tick the event is delivered at.
+        //! \param pileUp The number of schedules due on the same tick.
+        void Expire(ScheduledEvent* event, KsTickType now, uint32_t pileUp);
+
+        //! \brief Converts a duration to scheduler ticks, rounded down.
+        static uint32_t ToTicks(uint32_t ms);
+
+        //! \brief Records the timing of a delivery in the statistics of a schedule.
+        static void RecordDelivery(ScheduleStats& stats, KsTickType lateness, uint32_t pileUp);
+
+        //! \brief Called by the timer task on every tick, it only notifies the task of the scheduler.
         static void TickStub(TimerHandle_t timerHandle);
+
+        //! \brief Entry point of the task of the scheduler.
+        static void Start(void* data);
+
+        //! \brief Main loop of the task, runs a tick for every notification of the timer.
+        [[noreturn]] void Run();
+
+        //! \brief Advances the wheel by one tick and delivers the events that are due.
         void Tick();
 
     private:
+        //! Serializes the wheel and the schedules between the task of the scheduler and the callers of the API
+        SemaphoreHandle_t m_Lock = nullptr;
         TimerHandle_t m_Timer = nullptr;
-        Map <uint32_t, ScheduledBus> m_ScheduledBusses;
+        //! Task advancing the wheel and delivering the events
+        TaskHandle_t m_Task = nullptr;
+#if KS_STATIC_ALLOCATION
+        //! Control block of m_Lock
+        StaticSemaphore_t m_LockControl{};
+        //! Control block of m_Timer
+        StaticTimer_t m_TimerControl{};
+        //! Control block of m_Task
+        StaticTask_t m_TaskControl{};
+#endif
+        std::atomic<uint32_t> m_MaxBacklog{ 0 };
+        //! OS tick the scheduler started at, scheduler tick n is due n * KS_DEFAULT_TIMER_INTERVAL ms later
+        KsTickType m_Epoch = 0;
+        TimingWheel m_Wheel;
+        //! Number of periodic events due on every tick of the phase window
+        uint16_t m_Load[KS_SCHEDULER_PHASE_WINDOW]{};
+        ScheduledEvent m_Events[KS_SCHEDULER_CAPACITY];
+        //! Schedules that aren't used, linked through WheelEntry::next
+        WheelEntry* m_Free = nullptr;
+        Subscription m_Subscriptions[KS_SCHEDULER_SUBSCRIBERS];
+        //! Number of schedules using each subscription, which is free when it drops to 0
+        uint16_t m_SubscriptionUsers[KS_SCHEDULER_SUBSCRIBERS]{};
     };
 
 }
@@ -0,0 +1,62 @@
+#include "ks_timing_wheel.h"
+
+namespace kronos {
+
+    void TimingWheel::Insert(WheelEntry* entry, KsTickType deadline) {
+        Remove(entry);
+
+        // Compared as a difference so that the tick count can wrap around
+        if (static_cast<int32_t>(deadline - m_Now) <= 0) deadline = m_Now + 1;
+
+        entry->deadline = deadline;
+        Place(entry);
+        m_Size++;
+    }
+
+    void TimingWheel::Remove(WheelEntry* entry) {
+        if (!Contains(entry)) return;
+
+        *entry->pprev = entry->next;
+        if (entry->next != nullptr) entry->next->pprev = entry->pprev;
+
+        entry->next = nullptr;
+        entry->pprev = nullptr;
+        m_Size--;
+    }
+
+    KsTickType TimingWheel::GetNow() const {
+        return m_Now;
+    }
+
+    size_t TimingWheel::GetSize() const {
+        return m_Size;
+    }
+
+    void TimingWheel::Place(WheelEntry* entry) {
+        KsTickType delta = entry->deadline - m_Now;
+
+        size_t level = 0;
+        while (level + 1 < s_Levels && delta >= Span(level + 1))
+            level++;
+
+        // Out of range deadlines wait in the furthest slot of the last level and are placed again from there
+        KsTickType at = delta >= Span(s_Levels) ? m_Now + Span(s_Levels) - 1 : entry->deadline;
+
+        WheelEntry*& slot = m_Slots[level][(at >> (s_Bits * level)) & s_Mask];
+        entry->next = slot;
+        entry->pprev = &slot;
+        if (slot != nullptr) slot->pprev = &entry->next;
+        slot = entry;
+    }
+
+    void TimingWheel::Cascade(size_t level) {
+        WheelEntry* entry = std::exchange(m_Slots[level][(m_Now >> (s_Bits * level)) & s_Mask], nullptr);
+
+        while (entry != nullptr) {
+            WheelEntry* next = entry->next;
+            Place(entry);
+            entry = next;
+        }
+    }
+
+}
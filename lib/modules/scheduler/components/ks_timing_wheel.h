@@ -0,0 +1,104 @@
+#pragma once
+
+namespace kronos {
+
+    //! \struct WheelEntry
+    //! \brief Link of an entry of a TimingWheel, embedded in the object the wheel keeps track of.
+    struct WheelEntry {
+        //! Next entry of the same slot
+        WheelEntry* next = nullptr;
+        //! Link pointing to this entry, nullptr while the entry isn't in the wheel
+        WheelEntry** pprev = nullptr;
+        //! Tick at which the entry is due
+        KsTickType deadline = 0;
+    };
+
+    //! \class TimingWheel
+    //! \brief Hierarchical timing wheel, holds entries until the tick they are due at.
+    //!
+    //! Every level is a ring of 2^KS_SCHEDULER_WHEEL_BITS slots, and each slot of a level spans a whole turn of the
+    //! level below it. An entry is placed on the lowest level whose turn reaches its deadline, and moves down when
+    //! the wheel reaches its slot. Inserting and removing an entry is O(1), and advancing the wheel only touches the
+    //! entries that are due and the ones moving down a level, which each entry does at most once per level.
+    //! Deadlines beyond the span of the wheel wait on the last level until they come in range.
+    //!
+    //! The wheel isn't thread safe, its owner serializes the calls.
+    class TimingWheel {
+    public:
+        static constexpr size_t s_Bits = KS_SCHEDULER_WHEEL_BITS;
+        static constexpr size_t s_Levels = KS_SCHEDULER_WHEEL_LEVELS;
+        static constexpr size_t s_Slots = size_t(1) << s_Bits;
+        static_assert(s_Levels > 0 && s_Bits * s_Levels < 32, "The timing wheel must span less than 2^32 ticks!");
+
+        TimingWheel() = default;
+
+        TimingWheel(const TimingWheel& other) = delete;
+        void operator=(const TimingWheel& other) = delete;
+
+        //! \brief Adds an entry to the wheel, or moves it if it is already in the wheel.
+        //!
+        //! \param entry The entry, it must stay alive until it is removed or due.
+        //! \param deadline Tick at which the entry is due, a tick that already passed is due on the next one.
+        void Insert(WheelEntry* entry, KsTickType deadline);
+
+        //! \brief Takes an entry out of the wheel, nothing happens if it isn't in it.
+        void Remove(WheelEntry* entry);
+
+        //! \brief Checks whether an entry is waiting in the wheel.
+        [[nodiscard]] static bool Contains(const WheelEntry* entry) {
+            return entry->pprev != nullptr;
+        }
+
+        //! \brief Advances the wheel by one tick and takes out every entry due at it.
+        //!
+        //! \param expire Called with every entry that is due, it may insert the entry again.
+        //! \return The number of entries that were due.
+        template<typename F>
+        size_t Advance(F&& expire) {
+            m_Now++;
+
+            // A level moves its next slot down every time the levels below it complete a turn
+            for (size_t level = 1; level < s_Levels; level++) {
+                if ((m_Now & (Span(level) - 1)) != 0) break;
+                Cascade(level);
+            }
+
+            size_t due = 0;
+            WheelEntry*& slot = m_Slots[0][m_Now & s_Mask];
+            while (slot != nullptr) {
+                WheelEntry* entry = slot;
+                Remove(entry);
+                expire(entry);
+                due++;
+            }
+
+            return due;
+        }
+
+        //! \brief Getter for the tick the wheel is at.
+        [[nodiscard]] KsTickType GetNow() const;
+
+        //! \brief Getter for the number of entries waiting in the wheel.
+        [[nodiscard]] size_t GetSize() const;
+
+    private:
+        static constexpr KsTickType s_Mask = s_Slots - 1;
+
+        //! \brief Getter for the number of ticks spanned by a whole turn of the levels below a level.
+        static constexpr KsTickType Span(size_t level) {
+            return KsTickType(1) << (s_Bits * level);
+        }
+
+        //! \brief Links an entry into the slot of its deadline.
+        void Place(WheelEntry* entry);
+
+        //! \brief Moves every entry of the current slot of a level to the levels below it.
+        void Cascade(size_t level);
+
+    private:
+        WheelEntry* m_Slots[s_Levels][s_Slots]{};
+        KsTickType m_Now = 0;
+        size_t m_Size = 0;
+    };
+
+}
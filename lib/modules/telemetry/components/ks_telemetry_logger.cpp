@@ -15,13 +15,13 @@ namespace kronos {
                 KS_TRY(ks_error_component_process_event, Update());
                 break;
             case ks_event_tlm_set_active_group:
-                KS_TRY(ks_error_component_process_event, SetActiveTelemetryGroup(std::any_cast<uint8_t>(message.data)));
+                KS_TRY(ks_error_component_process_event, SetActiveTelemetryGroup(message.Cast<uint8_t>()));
                 break;
             case ks_event_tlm_list_groups:
                 KS_TRY(ks_error_component_process_event, ListTelemetryGroups());
                 break;
             case ks_event_tlm_list_channels:
-                KS_TRY(ks_error_component_process_event, ListTelemetryChannels(std::any_cast<uint8_t>(message.data)));
+                KS_TRY(ks_error_component_process_event, ListTelemetryChannels(message.Cast<uint8_t>()));
                 break;
         }
 
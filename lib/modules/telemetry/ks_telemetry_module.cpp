@@ -19,7 +19,7 @@ namespace kronos {
     KsResult TlmModule::Init() const {
         KS_TRY(ks_error_module_initialize, Framework::CreateSingletonComponent<TelemetryLogger>());
 
-        auto* bus = Framework::CreateBus<Bus>("B_TLM_LOGGER");
+        auto* bus = Framework::CreateBus<Bus>(KS_BUS_TLM_LOGGER);
         KS_TRY(ks_error_module_initialize, bus->AddReceivingComponent(&TelemetryLogger::GetInstance()));
 
         KS_TRY(ks_error_module_initialize, WorkerManager::RegisterComponent(ks_worker_main, &TelemetryLogger::GetInstance()));
@@ -10,23 +10,90 @@ namespace kronos {
 
     WorkerManager::WorkerManager() : ComponentPassive("CP_WORKER_MANAGER") {
         for (const auto& [id, config]: s_WorkerConfig) {
+            _CreatePool(id, config);
+        }
+    }
+
+    KsResult WorkerManager::_CreatePool(KsWorkerPoolId poolId, const KsWorkerConfig& config) {
+        if (m_Pools.contains(poolId)) KS_THROW(ks_error_component_exists);
+
+        auto& pool = m_Pools[poolId];
+        pool.config = config;
+
+        for (size_t i = 0; i < config.workers; i++) {
             auto worker = Framework::CreateComponent<ComponentWorker>(
-                "CW_" + std::to_string(id),
+                "CW_" + std::to_string(poolId) + "_" + std::to_string(i),
                 config.stackSize,
                 config.priority
             );
 
-//            if(worker) return;
+            if (worker == nullptr) KS_THROW(ks_error_component_create);
+            pool.workers.push_back(worker);
+        }
+
+        // The list is complete, the workers can keep a view of it
+        for (auto worker: pool.workers)
+            worker->SetPool(pool.workers);
+
+        return ks_success;
+    }
+
+    KsResult WorkerManager::_RegisterComponent(KsWorkerPoolId poolId, ComponentQueued* component, uint16_t priority) {
+        // Modules of a dependency level register their components from several boot tasks
+        Framework::RegistryLock lock;
+
+        KS_MAP_FIND(m_Pools, poolId, it) {
+            ComponentWorker* worker = PickWorker(it->second);
+            if (worker == nullptr) KS_THROW(ks_error_component_worker_full);
+
+            return worker->RegisterComponent(component, priority);
+        }
+
+        KS_THROW(ks_error_component_worker_missing);
+    }
 
-            m_Workers[id] = worker;
+    std::span<ComponentWorker* const> WorkerManager::_GetWorkers(KsWorkerPoolId poolId) {
+        KS_MAP_FIND(m_Pools, poolId, it) {
+            return it->second.workers;
         }
+
+        return {};
     }
 
-    KsResult WorkerManager::_RegisterComponent(KsIdType workerId, ComponentQueued* component) {
-        return m_Workers[workerId]->RegisterComponent(component);
+    ComponentWorker* WorkerManager::PickWorker(WorkerPool& pool) {
+        auto& workers = pool.workers;
+        if (workers.empty()) return nullptr;
+
+        if (pool.config.policy == ks_worker_policy_round_robin) {
+            for (size_t i = 0; i < workers.size(); i++) {
+                ComponentWorker* worker = workers[pool.next++ % workers.size()];
+                if (worker->GetComponentCount() < ComponentWorker::s_MaxComponents) return worker;
+            }
+
+            return nullptr;
+        }
+
+        ComponentWorker* picked = nullptr;
+        for (auto worker: workers) {
+            if (worker->GetComponentCount() >= ComponentWorker::s_MaxComponents) continue;
+
+            if (picked == nullptr
+                || worker->GetLoad() < picked->GetLoad()
+                || (worker->GetLoad() == picked->GetLoad() && worker->GetComponentCount() < picked->GetComponentCount()))
+                picked = worker;
+        }
+
+        return picked;
     }
 
-    Map <KsIdType, KsWorkerConfig> WorkerManager::s_WorkerConfig{
+    Map <KsWorkerPoolId, KsWorkerConfig> WorkerManager::s_WorkerConfig{
+        {
+            ks_worker_high,
+            {
+                .stackSize = KS_COMPONENT_STACK_SIZE_LARGE,
+                .priority = KS_COMPONENT_PRIORITY_HIGH
+            }
+        },
         {
             ks_worker_main,
             {
@@ -3,15 +3,36 @@
 #include "ks_component_worker.h"
 
 namespace kronos {
-    enum KsIdType {
+    enum KsWorkerPoolId {
+        //! Latency sensitive components, such as the command transmitter
+        ks_worker_high,
+        //! Every other component, including the ones doing slow flash writes
         ks_worker_main
     };
 
+    //! \enum KsWorkerPolicy
+    //! \brief How a pool picks the worker that hosts a newly registered component.
+    enum KsWorkerPolicy : uint8_t {
+        //! The worker with the lowest measured load, then with the fewest components
+        ks_worker_policy_least_loaded,
+        //! Each worker in turn
+        ks_worker_policy_round_robin
+    };
+
     struct KsWorkerConfig {
         size_t stackSize;
         uint16_t priority;
+        //! Number of workers in the pool
+        size_t workers = 1;
+        KsWorkerPolicy policy = ks_worker_policy_least_loaded;
     };
 
+    //! \class WorkerManager
+    //! \brief Creates the worker pools and assigns the queued components to their workers.
+    //!
+    //! Each pool runs its workers at the priority of the pool, so components registered to different pools never
+    //! delay each other. Within a pool with several workers, components are assigned by the policy of the pool
+    //! and then migrate between workers based on their measured queue latency, see ComponentWorker::Balance().
     class WorkerManager : public ComponentPassive {
     KS_SINGLETON(WorkerManager);
     public:
@@ -19,15 +40,41 @@ namespace kronos {
         ~WorkerManager() override = default;
 
     public:
+        KS_SINGLETON_EXPOSE_METHOD(_CreatePool,
+                                   KsResult CreatePool(KsWorkerPoolId poolId, const KsWorkerConfig& config),
+                                   poolId,
+                                   config);
+
         KS_SINGLETON_EXPOSE_METHOD(_RegisterComponent,
-                                   KsResult RegisterComponent(KsIdType workerId, ComponentQueued* component),
-                                   workerId,
-                                   component);
+                                   KsResult RegisterComponent(
+                                       KsWorkerPoolId poolId,
+                                       ComponentQueued* component,
+                                       uint16_t priority = KS_COMPONENT_PRIORITY_MEDIUM
+                                   ),
+                                   poolId,
+                                   component,
+                                   priority);
+
+        KS_SINGLETON_EXPOSE_METHOD(_GetWorkers,
+                                   std::span<ComponentWorker* const> GetWorkers(KsWorkerPoolId poolId),
+                                   poolId);
 
     private:
-        KsResult _RegisterComponent(KsIdType workerId, ComponentQueued* component);
+        //! A pool of workers sharing the same configuration
+        struct WorkerPool {
+            KsWorkerConfig config;
+            List<ComponentWorker*> workers;
+            //! Next worker picked by ks_worker_policy_round_robin
+            size_t next = 0;
+        };
+
+        KsResult _CreatePool(KsWorkerPoolId poolId, const KsWorkerConfig& config);
+        KsResult _RegisterComponent(KsWorkerPoolId poolId, ComponentQueued* component, uint16_t priority);
+        std::span<ComponentWorker* const> _GetWorkers(KsWorkerPoolId poolId);
+
+        ComponentWorker* PickWorker(WorkerPool& pool);
 
-        static Map <KsIdType, KsWorkerConfig> s_WorkerConfig;
-        Map<KsIdType, ComponentWorker*> m_Workers;
+        static Map <KsWorkerPoolId, KsWorkerConfig> s_WorkerConfig;
+        Map<KsWorkerPoolId, WorkerPool> m_Pools;
     };
-}
\ No newline at end of file
+}
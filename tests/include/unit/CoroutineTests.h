@@ -0,0 +1,6 @@
+#pragma once
+
+#include "KronosTest.h"
+
+extern KT_TEST(CoroutineEventTest);
+extern KT_TEST(CoroutineCompletionTest);
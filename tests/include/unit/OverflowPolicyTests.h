@@ -0,0 +1,9 @@
+#pragma once
+
+#include "KronosTest.h"
+
+extern KT_TEST(OverflowDropNewestTest);
+extern KT_TEST(OverflowDropOldestTest);
+extern KT_TEST(OverflowBatchDropOldestTest);
+extern KT_TEST(OverflowCoalesceTest);
+extern KT_TEST(OverflowCoalesceMixedTest);
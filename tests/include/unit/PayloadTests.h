@@ -0,0 +1,7 @@
+#pragma once
+
+#include "KronosTest.h"
+
+extern KT_TEST(PayloadInlineTest);
+extern KT_TEST(PayloadBlockTest);
+extern KT_TEST(PayloadAdoptTest);
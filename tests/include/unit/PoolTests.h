@@ -0,0 +1,7 @@
+#pragma once
+
+#include "KronosTest.h"
+
+extern KT_TEST(PoolAcquireAndReleaseTest);
+extern KT_TEST(PoolExhaustionTest);
+extern KT_TEST(PoolForeignReleaseTest);
@@ -0,0 +1,7 @@
+#pragma once
+
+#include "KronosTest.h"
+
+extern KT_TEST(TimingWheelTest);
+extern KT_TEST(TimingWheelRemoveTest);
+extern KT_TEST(SchedulePhaseTest);
@@ -0,0 +1,5 @@
+#pragma once
+
+#include "KronosTest.h"
+
+extern KT_TEST(TopologyTest);
@@ -0,0 +1,7 @@
+#pragma once
+
+#include "KronosTest.h"
+
+extern KT_TEST(WorkerRegisterTest);
+extern KT_TEST(WorkerBalanceTest);
+extern KT_TEST(WorkerBudgetTest);
@@ -1,6 +1,19 @@
 #include "KronosTest.h"
 
 #include "unit/QueueTests.h"
+#include "unit/PoolTests.h"
+#include "unit/PayloadTests.h"
+#include "unit/IsrPublishTests.h"
+#include "unit/OverflowPolicyTests.h"
+#include "unit/HandleTests.h"
+#include "unit/TopologyTests.h"
+#include "unit/AsyncCallTests.h"
+#include "unit/EventFilterTests.h"
+#include "unit/WorkerTests.h"
+#include "unit/CoroutineTests.h"
+#include "unit/BootTests.h"
+#include "unit/QueueSizeTests.h"
+#include "unit/SchedulerTests.h"
 #include "unit/FileTests.h"
 #include "unit/ApolloTests.h"
 
@@ -18,6 +31,77 @@ KT_TESTS(
     KT_UNIT_TEST(QueueCapacityTest, "Description of the test.")
 )
 
+    KT_TEST_GROUP(PoolTests,
+    KT_UNIT_TEST(PoolAcquireAndReleaseTest, "Verifies that objects are constructed and given back to the pool.")
+    KT_UNIT_TEST(PoolExhaustionTest, "Verifies that an empty pool fails gracefully and reuses released slots.")
+    KT_UNIT_TEST(PoolForeignReleaseTest, "Verifies that objects not owned by the pool are rejected.")
+)
+
+    KT_TEST_GROUP(PayloadTests,
+    KT_UNIT_TEST(PayloadInlineTest, "Verifies that small values are stored inline and type checked.")
+    KT_UNIT_TEST(PayloadBlockTest, "Verifies that large values use a pooled block that is returned on destruction.")
+    KT_UNIT_TEST(PayloadAdoptTest, "Verifies that an adopted value is handed back to its owner on reset.")
+)
+
+    KT_TEST_GROUP(IsrPublishTests,
+    KT_UNIT_TEST(PublishFromISRTest, "Verifies that an event published from a simulated interrupt reaches a queued component.")
+    KT_UNIT_TEST(PublishFromISRNoSubscribersTest, "Verifies that publishing from an interrupt without subscribers allocates nothing.")
+)
+
+    KT_TEST_GROUP(OverflowPolicyTests,
+    KT_UNIT_TEST(OverflowDropNewestTest, "Verifies that a full queue drops new events and counts them.")
+    KT_UNIT_TEST(OverflowDropOldestTest, "Verifies that a full queue drops its oldest event to make room.")
+    KT_UNIT_TEST(OverflowBatchDropOldestTest, "Verifies that a batch counts its events before evicting one.")
+    KT_UNIT_TEST(OverflowCoalesceTest, "Verifies that events with the same code are merged while one is waiting.")
+    KT_UNIT_TEST(OverflowCoalesceMixedTest, "Verifies that only the coalesced event frees its code when popped.")
+)
+
+    KT_TEST_GROUP(HandleTests,
+    KT_UNIT_TEST(HandleResolveTest, "Verifies that a bus handle resolves once to the bus created with its name.")
+    KT_UNIT_TEST(HandleMissingTest, "Verifies that a handle to an unknown name stays unresolved.")
+)
+
+    KT_TEST_GROUP(TopologyTests,
+    KT_UNIT_TEST(TopologyTest, "Verifies that a static topology is resolved by handles and delivers from its tables.")
+)
+
+    KT_TEST_GROUP(AsyncCallTests,
+    KT_UNIT_TEST(AsyncCallCompleteTest, "Verifies that a response is matched to its call by correlation id.")
+    KT_UNIT_TEST(AsyncCallTimeoutTest, "Verifies that an unanswered call fails once its timeout expires.")
+)
+
+    KT_TEST_GROUP(EventFilterTests,
+    KT_UNIT_TEST(EventFilterPublishTest, "Verifies that events are only created for the subscribers that want them.")
+    KT_UNIT_TEST(EventFilterBatchTest, "Verifies that each subscriber only receives the filtered part of a batch.")
+)
+
+    KT_TEST_GROUP(WorkerTests,
+    KT_UNIT_TEST(WorkerRegisterTest, "Verifies that components can be registered to and removed from a worker.")
+    KT_UNIT_TEST(WorkerBalanceTest, "Verifies that a pool doesn't move components that don't wait.")
+    KT_UNIT_TEST(WorkerBudgetTest, "Verifies that a visit to a queue stops at the budget of the component.")
+)
+
+    KT_TEST_GROUP(CoroutineTests,
+    KT_UNIT_TEST(CoroutineEventTest, "Verifies that a coroutine component processes events through an awaited handler.")
+    KT_UNIT_TEST(CoroutineCompletionTest, "Verifies that a coroutine resumes once the completion it awaits is signaled.")
+)
+
+    KT_TEST_GROUP(BootTests,
+    KT_UNIT_TEST(BootTimelineTest, "Verifies that boot steps are timed and recorded up to the size of the timeline.")
+    KT_UNIT_TEST(BootPoolTest, "Verifies that a boot pool runs every step once and reports the first failure.")
+)
+
+    KT_TEST_GROUP(QueueSizeTests,
+    KT_UNIT_TEST(QueueSizeTest, "Verifies that the lanes of a component are sized at construction and fixed once created.")
+    KT_UNIT_TEST(QueueHighWaterTest, "Verifies that the deepest point of every lane is recorded until reset.")
+)
+
+    KT_TEST_GROUP(SchedulerTests,
+    KT_UNIT_TEST(TimingWheelTest, "Verifies that entries of the timing wheel are due exactly at their deadline on every level.")
+    KT_UNIT_TEST(TimingWheelRemoveTest, "Verifies that entries of the timing wheel can be removed, moved and inserted again when due.")
+    KT_UNIT_TEST(SchedulePhaseTest, "Verifies that schedules are due on their phase and that automatic phases avoid loaded ticks.")
+)
+
     KT_TEST_GROUP(FileTests,
     KT_UNIT_TEST(FileInitTest, "Verifies that the kronos::File Properly Initializes.")
     KT_UNIT_TEST(FileReadWriteTest, "Verifies that the kronos::File Properly Reads and Writes into a File in the File System.")
@@ -0,0 +1,87 @@
+#include "KronosTest.h"
+#include "ks_async_call.h"
+
+using namespace kronos;
+
+//! Passive component answering every request with twice its value, unless it is muted.
+class AsyncCallResponder : public ComponentPassive {
+public:
+    AsyncCallResponder() : ComponentPassive("CP_TEST_ASYNC_RESPONDER") {}
+
+    KsResult ProcessEvent(const EventMessage& message) override {
+        if (muted) return ks_success;
+        return Bus::Reply(message, message.Cast<uint32_t>() * 2, ks_event_toggle_led);
+    }
+
+    bool muted = false;
+};
+
+//! Passive component making calls and completing them with the responses it receives.
+class AsyncCallCaller : public ComponentPassive {
+public:
+    explicit AsyncCallCaller(Bus* replyBus) : ComponentPassive("CP_TEST_ASYNC_CALLER"), calls(replyBus) {}
+
+    KsResult ProcessEvent(const EventMessage& message) override {
+        if (!calls.Complete(message)) late++;
+        return ks_success;
+    }
+
+    static void OnResponse(void* context, const EventMessage* response, KsResult result) {
+        auto* caller = static_cast<AsyncCallCaller*>(context);
+        caller->result = result;
+        if (response != nullptr) caller->value = response->Cast<uint32_t>();
+    }
+
+    AsyncCall<> calls;
+    KsResult result = ks_error;
+    uint32_t value = 0;
+    size_t late = 0;
+};
+
+KT_TEST(AsyncCallCompleteTest) {
+    Bus requestBus("B_TEST_ASYNC_REQUEST");
+    Bus replyBus("B_TEST_ASYNC_REPLY");
+    AsyncCallResponder responder;
+    AsyncCallCaller caller(&replyBus);
+    KT_ASSERT(requestBus.AddReceivingComponent(&responder) == ks_success);
+    KT_ASSERT(replyBus.AddReceivingComponent(&caller) == ks_success);
+
+    KsCorrelationIdType id = 0;
+    KT_ASSERT(caller.calls.Call(
+        &requestBus,
+        (uint32_t) 21,
+        ks_event_toggle_led,
+        &AsyncCallCaller::OnResponse,
+        &caller,
+        KS_ASYNC_CALL_DEFAULT_TIMEOUT,
+        &id
+    ) == ks_success);
+
+    KT_ASSERT(id != 0);
+    KT_ASSERT(caller.result == ks_success);
+    KT_ASSERT(caller.value == 42);
+    KT_ASSERT(caller.calls.GetPending() == 0);
+    KT_ASSERT(caller.calls.Cancel(id) == ks_error_async_call_missing);
+
+    return true;
+}
+
+KT_TEST(AsyncCallTimeoutTest) {
+    Bus requestBus("B_TEST_ASYNC_REQUEST");
+    Bus replyBus("B_TEST_ASYNC_REPLY");
+    AsyncCallResponder responder;
+    AsyncCallCaller caller(&replyBus);
+    responder.muted = true;
+    KT_ASSERT(requestBus.AddReceivingComponent(&responder) == ks_success);
+    KT_ASSERT(replyBus.AddReceivingComponent(&caller) == ks_success);
+
+    KT_ASSERT(caller.calls.Call(&requestBus, (uint32_t) 1, ks_event_toggle_led, &AsyncCallCaller::OnResponse, &caller, 0)
+              == ks_success);
+    KT_ASSERT(caller.calls.GetPending() == 1);
+
+    KT_ASSERT(caller.calls.Expire() == 1);
+    KT_ASSERT(caller.result == ks_error_async_call_timeout);
+    KT_ASSERT(caller.calls.GetPending() == 0);
+
+    return true;
+}
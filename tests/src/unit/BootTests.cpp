@@ -0,0 +1,48 @@
+#include "KronosTest.h"
+#include "ks_boot.h"
+
+using namespace kronos;
+
+KT_TEST(BootTimelineTest) {
+    static BootTimeline timeline;
+
+    KsResult result = timeline.Time(ks_boot_step_module, HashID("TestModule"), 1, 0, [] {
+        return ks_error_module_initialize;
+    });
+
+    KT_ASSERT(result == ks_error_module_initialize);
+    KT_ASSERT(timeline.GetRecords().size() == 1);
+    KT_ASSERT(timeline.GetRecords()[0].id == HashID("TestModule"));
+    KT_ASSERT(timeline.GetRecords()[0].result == ks_error_module_initialize);
+    KT_ASSERT(timeline.GetRecords()[0].level == 1);
+
+    for (size_t i = 0; i < KS_BOOT_TIMELINE_SIZE; i++)
+        timeline.Record({ .id = HashID("TestComponent"), .step = ks_boot_step_component_init });
+
+    KT_ASSERT(timeline.GetRecords().size() == KS_BOOT_TIMELINE_SIZE);
+    KT_ASSERT(timeline.GetDropped() == 1);
+
+    return true;
+}
+
+KT_TEST(BootPoolTest) {
+    BootPool pool;
+    std::atomic<uint32_t> ran[8]{};
+
+    KsResult result = pool.Run(std::size(ran), [&](size_t index, uint8_t task) {
+        ran[index].fetch_add(1);
+        return ks_success;
+    });
+
+    KT_ASSERT(result == ks_success);
+    for (const auto& count: ran)
+        KT_ASSERT(count.load() == 1);
+
+    result = pool.Run(std::size(ran), [](size_t index, uint8_t task) {
+        return index == 0 ? ks_error_component_initialize : ks_success;
+    });
+
+    KT_ASSERT(result == ks_error_component_initialize);
+
+    return true;
+}
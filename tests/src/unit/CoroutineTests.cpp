@@ -0,0 +1,85 @@
+#include "KronosTest.h"
+#include "ks_bus.h"
+#include "ks_component_coroutine.h"
+
+using namespace kronos;
+
+//! Coroutine component summing the values it receives through an awaited handler.
+class CoroutineSumComponent : public ComponentCoroutine {
+public:
+    CoroutineSumComponent() : ComponentCoroutine("CC_TEST_SUM") {}
+
+    uint32_t sum = 0;
+    size_t handled = 0;
+
+protected:
+    CoroutineTask Main() override {
+        while (true) {
+            const EventMessage& message = co_await NextEvent();
+            co_await Add(message.Cast<uint32_t>());
+        }
+    }
+
+    CoroutineTask Add(uint32_t value) {
+        sum += value;
+        handled++;
+        co_return;
+    }
+};
+
+//! Coroutine component waiting for an operation to complete before it processes events.
+class CoroutineCompletionComponent : public ComponentCoroutine {
+public:
+    CoroutineCompletionComponent() : ComponentCoroutine("CC_TEST_COMPLETION") {}
+
+    Completion completion;
+    KsResult result = ks_error;
+
+protected:
+    CoroutineTask Main() override {
+        result = co_await Await(completion);
+        co_await NextEvent();
+    }
+};
+
+KT_TEST(CoroutineEventTest) {
+    Bus bus("B_TEST_COROUTINE");
+    CoroutineSumComponent component;
+    KT_ASSERT(component.Init() == ks_success);
+    KT_ASSERT(bus.AddReceivingComponent(&component) == ks_success);
+
+    // The first visit runs the coroutine up to its first await
+    KT_ASSERT(component.ProcessEventQueue() == ks_success);
+    KT_ASSERT(component.GetWait() == ks_coroutine_wait_event);
+
+    KT_ASSERT(bus.Publish(uint32_t(1), ks_event_toggle_led) == ks_success);
+    KT_ASSERT(bus.Publish(uint32_t(2), ks_event_toggle_led) == ks_success);
+    KT_ASSERT(component.ProcessEventQueue() == ks_success);
+    KT_ASSERT(component.handled == 2);
+    KT_ASSERT(component.sum == 3);
+
+    // Only the frame of Main() is left, the handler frames went back to the pool
+    KT_ASSERT(CoroutineTask::GetFramePoolStats().inUse == 1);
+    KT_ASSERT(component.Destroy() == ks_success);
+    KT_ASSERT(CoroutineTask::GetFramePoolStats().inUse == 0);
+
+    return true;
+}
+
+KT_TEST(CoroutineCompletionTest) {
+    CoroutineCompletionComponent component;
+    KT_ASSERT(component.Init() == ks_success);
+
+    KT_ASSERT(component.ProcessEventQueue() == ks_success);
+    KT_ASSERT(component.GetWait() == ks_coroutine_wait_completion);
+    KT_ASSERT(!component.HasWork());
+
+    component.completion.Signal(ks_success);
+    KT_ASSERT(component.HasWork());
+    KT_ASSERT(component.ProcessEventQueue() == ks_success);
+    KT_ASSERT(component.result == ks_success);
+    KT_ASSERT(component.GetWait() == ks_coroutine_wait_event);
+
+    KT_ASSERT(component.Destroy() == ks_success);
+    return true;
+}
@@ -0,0 +1,56 @@
+#include "KronosTest.h"
+#include "ks_bus.h"
+
+using namespace kronos;
+
+//! Passive component counting the events it processes.
+class FilterTestComponent : public ComponentPassive {
+public:
+    explicit FilterTestComponent(const String& name) : ComponentPassive(name) {}
+
+    KsResult ProcessEvent(const EventMessage& message) override {
+        received++;
+        return ks_success;
+    }
+
+    size_t received = 0;
+};
+
+KT_TEST(EventFilterPublishTest) {
+    Bus bus("B_TEST_FILTER");
+    FilterTestComponent filtered("CP_TEST_FILTERED");
+    KT_ASSERT(bus.AddReceivingComponent(&filtered, { ks_event_toggle_led }) == ks_success);
+
+    // No subscriber wants the event, so no message is created for it
+    auto acquired = Framework::GetEventMessagePoolStats().acquired;
+    KT_ASSERT(bus.Publish((uint32_t) 1, ks_event_save_param) == ks_success);
+    KT_ASSERT(Framework::GetEventMessagePoolStats().acquired == acquired);
+    KT_ASSERT(filtered.received == 0);
+
+    KT_ASSERT(bus.Publish((uint32_t) 1, ks_event_toggle_led) == ks_success);
+    KT_ASSERT(filtered.received == 1);
+
+    KT_ASSERT(bus.AddReceivingEvents(&filtered, { ks_event_save_param }) == ks_success);
+    KT_ASSERT(bus.Publish((uint32_t) 1, ks_event_save_param) == ks_success);
+    KT_ASSERT(filtered.received == 2);
+    KT_ASSERT(Framework::GetEventMessagePoolStats().inUse == 0);
+
+    return true;
+}
+
+KT_TEST(EventFilterBatchTest) {
+    Bus bus("B_TEST_FILTER_BATCH");
+    FilterTestComponent filtered("CP_TEST_FILTERED");
+    FilterTestComponent unfiltered("CP_TEST_UNFILTERED");
+    KT_ASSERT(bus.AddReceivingComponent(&filtered, { ks_event_toggle_led }) == ks_success);
+    KT_ASSERT(bus.AddReceivingComponent(&unfiltered) == ks_success);
+
+    KsEventCodeType eventCodes[] = { ks_event_toggle_led, ks_event_save_param, ks_event_toggle_led };
+    KT_ASSERT(bus.PublishBatch(eventCodes) == ks_success);
+
+    KT_ASSERT(filtered.received == 2);
+    KT_ASSERT(unfiltered.received == 3);
+    KT_ASSERT(Framework::GetEventMessagePoolStats().inUse == 0);
+
+    return true;
+}
@@ -0,0 +1,27 @@
+#include "KronosTest.h"
+#include "ks_bus.h"
+
+using namespace kronos;
+
+KT_TEST(HandleResolveTest) {
+    static_assert(BusHandle<>("B_TEST_HANDLE").GetId() == HashID("B_TEST_HANDLE"));
+
+    Bus* bus = Framework::CreateBus("B_TEST_HANDLE");
+    KT_ASSERT(bus != nullptr);
+
+    BusHandle<> handle("B_TEST_HANDLE");
+    KT_ASSERT(!handle.IsResolved());
+    KT_ASSERT(handle.Get() == bus);
+    KT_ASSERT(handle.IsResolved());
+    KT_ASSERT(handle.Get() == Framework::GetBus("B_TEST_HANDLE"));
+
+    return true;
+}
+
+KT_TEST(HandleMissingTest) {
+    BusHandle<> handle("B_TEST_HANDLE_MISSING");
+    KT_ASSERT(handle.Get() == nullptr);
+    KT_ASSERT(!handle.IsResolved());
+
+    return true;
+}
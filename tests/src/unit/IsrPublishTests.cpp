@@ -0,0 +1,71 @@
+#include "KronosTest.h"
+#include "ks_bus.h"
+
+using namespace kronos;
+
+//! Queued component recording the events it processes.
+class IsrTestComponent : public ComponentQueued {
+public:
+    IsrTestComponent() : ComponentQueued("CQ_TEST_ISR") {}
+
+    KsResult ProcessEvent(const EventMessage& message) override {
+        received++;
+        value = message.Cast<uint32_t>();
+        return ks_success;
+    }
+
+    size_t received = 0;
+    uint32_t value = 0;
+};
+
+//! Simulates an interrupt source: the handler runs with interrupts masked and the context switch is deferred until
+//! it returns, like it would be at the end of a real interrupt.
+template<typename F>
+static BaseType_t SimulateInterrupt(F&& handler) {
+    BaseType_t higherPriorityTaskWoken = pdFALSE;
+
+    UBaseType_t mask = portSET_INTERRUPT_MASK_FROM_ISR();
+    handler(&higherPriorityTaskWoken);
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+
+    portYIELD_FROM_ISR(higherPriorityTaskWoken);
+    return higherPriorityTaskWoken;
+}
+
+KT_TEST(PublishFromISRTest) {
+    Bus bus("B_TEST_ISR");
+    IsrTestComponent component;
+    KT_ASSERT(component.Init() == ks_success);
+    KT_ASSERT(bus.AddReceivingComponent(&component) == ks_success);
+
+    uint32_t inUse = Framework::GetEventMessagePoolStats().inUse;
+
+    KsResult result = ks_error;
+    SimulateInterrupt([&](BaseType_t* higherPriorityTaskWoken) {
+        result = bus.PublishFromISR(uint32_t{ 0xCAFE }, ks_event_toggle_led, higherPriorityTaskWoken);
+    });
+
+    KT_ASSERT(result == ks_success);
+    KT_ASSERT(component.ProcessEventQueue() == ks_success);
+    KT_ASSERT(component.received == 1);
+    KT_ASSERT(component.value == 0xCAFE);
+    KT_ASSERT(Framework::GetEventMessagePoolStats().inUse == inUse);
+
+    KT_ASSERT(component.Destroy() == ks_success);
+    return true;
+}
+
+KT_TEST(PublishFromISRNoSubscribersTest) {
+    Bus bus("B_TEST_ISR_EMPTY");
+    uint32_t acquired = Framework::GetEventMessagePoolStats().acquired;
+
+    KsResult result = ks_success;
+    SimulateInterrupt([&](BaseType_t* higherPriorityTaskWoken) {
+        result = bus.PublishFromISR(ks_event_toggle_led, higherPriorityTaskWoken);
+    });
+
+    KT_ASSERT(result == ks_error_bus_no_subscribers);
+    KT_ASSERT(Framework::GetEventMessagePoolStats().acquired == acquired);
+
+    return true;
+}
@@ -0,0 +1,133 @@
+#include "KronosTest.h"
+#include "ks_bus.h"
+
+using namespace kronos;
+
+//! Queued component recording the first and last values it processes.
+class OverflowTestComponent : public ComponentQueued {
+public:
+    OverflowTestComponent() : ComponentQueued("CQ_TEST_OVERFLOW") {}
+
+    KsResult ProcessEvent(const EventMessage& message) override {
+        if (received++ == 0) first = message.Cast<uint32_t>();
+        last = message.Cast<uint32_t>();
+        missed += GetMissedEvents(message);
+        return ks_success;
+    }
+
+    size_t received = 0;
+    uint32_t missed = 0;
+    uint32_t first = 0;
+    uint32_t last = 0;
+};
+
+KT_TEST(OverflowDropNewestTest) {
+    Bus bus("B_TEST_DROP_NEWEST");
+    OverflowTestComponent component;
+    KT_ASSERT(component.Init() == ks_success);
+    KT_ASSERT(bus.AddReceivingComponent(&component, ks_overflow_drop_newest) == ks_success);
+
+    for (uint32_t i = 0; i <= KS_QUEUE_DEFAULT_SIZE; i++)
+        KT_ASSERT(bus.Publish(i, ks_event_toggle_led) == ks_success);
+
+    KT_ASSERT(bus.GetDeliveryStats(&component)->dropped == 1);
+    KT_ASSERT(component.ProcessEventQueue() == ks_success);
+    KT_ASSERT(component.received == KS_QUEUE_DEFAULT_SIZE);
+    KT_ASSERT(component.first == 0);
+    KT_ASSERT(component.last == KS_QUEUE_DEFAULT_SIZE - 1);
+
+    KT_ASSERT(component.Destroy() == ks_success);
+    return true;
+}
+
+KT_TEST(OverflowDropOldestTest) {
+    Bus bus("B_TEST_DROP_OLDEST");
+    OverflowTestComponent component;
+    KT_ASSERT(component.Init() == ks_success);
+    KT_ASSERT(bus.AddReceivingComponent(&component, ks_overflow_drop_oldest) == ks_success);
+
+    for (uint32_t i = 0; i <= KS_QUEUE_DEFAULT_SIZE; i++)
+        KT_ASSERT(bus.Publish(i, ks_event_toggle_led) == ks_success);
+
+    KT_ASSERT(bus.GetDeliveryStats(&component)->evicted == 1);
+    KT_ASSERT(component.ProcessEventQueue() == ks_success);
+    KT_ASSERT(component.received == KS_QUEUE_DEFAULT_SIZE);
+    KT_ASSERT(component.first == 1);
+    KT_ASSERT(component.last == KS_QUEUE_DEFAULT_SIZE);
+
+    KT_ASSERT(component.Destroy() == ks_success);
+    return true;
+}
+
+KT_TEST(OverflowBatchDropOldestTest) {
+    Bus bus("B_TEST_BATCH_DROP_OLDEST");
+    OverflowTestComponent component;
+    KT_ASSERT(component.Init() == ks_success);
+    KT_ASSERT(bus.AddReceivingComponent(&component, ks_overflow_drop_oldest) == ks_success);
+
+    for (uint32_t i = 0; i < KS_QUEUE_DEFAULT_SIZE - 1; i++)
+        KT_ASSERT(bus.Publish(i, ks_event_toggle_led) == ks_success);
+
+    // The first event of the batch fills the queue, the second one evicts the oldest event
+    const uint32_t batch[] = { KS_QUEUE_DEFAULT_SIZE - 1, KS_QUEUE_DEFAULT_SIZE };
+    KT_ASSERT(bus.PublishBatch<uint32_t>(batch, ks_event_toggle_led) == ks_success);
+
+    KT_ASSERT(bus.GetDeliveryStats(&component)->evicted == 1);
+    KT_ASSERT(component.ProcessEventQueue() == ks_success);
+    KT_ASSERT(component.received == KS_QUEUE_DEFAULT_SIZE);
+    KT_ASSERT(component.first == 1);
+    KT_ASSERT(component.last == KS_QUEUE_DEFAULT_SIZE);
+
+    KT_ASSERT(component.Destroy() == ks_success);
+    return true;
+}
+
+KT_TEST(OverflowCoalesceTest) {
+    Bus bus("B_TEST_COALESCE");
+    OverflowTestComponent component;
+    KT_ASSERT(component.Init() == ks_success);
+    KT_ASSERT(bus.AddReceivingComponent(&component, ks_overflow_coalesce) == ks_success);
+
+    for (uint32_t i = 0; i < 5; i++)
+        KT_ASSERT(bus.Publish(i, ks_event_toggle_led) == ks_success);
+
+    KT_ASSERT(bus.GetDeliveryStats(&component)->coalesced == 4);
+    KT_ASSERT(component.ProcessEventQueue() == ks_success);
+    KT_ASSERT(component.received == 1);
+    KT_ASSERT(component.missed == 4);
+
+    // Once popped, the next event of the same code is queued again
+    KT_ASSERT(bus.Publish(uint32_t{ 5 }, ks_event_toggle_led) == ks_success);
+    KT_ASSERT(component.ProcessEventQueue() == ks_success);
+    KT_ASSERT(component.received == 2);
+    KT_ASSERT(component.missed == 4);
+    KT_ASSERT(component.last == 5);
+
+    KT_ASSERT(component.Destroy() == ks_success);
+    return true;
+}
+
+KT_TEST(OverflowCoalesceMixedTest) {
+    Bus coalesced("B_TEST_COALESCE_MIXED");
+    Bus plain("B_TEST_COALESCE_PLAIN");
+    OverflowTestComponent component;
+    KT_ASSERT(component.Init() == ks_success);
+    KT_ASSERT(coalesced.AddReceivingComponent(&component, ks_overflow_coalesce) == ks_success);
+    KT_ASSERT(plain.AddReceivingComponent(&component, ks_overflow_drop_newest) == ks_success);
+
+    // Popping an event of the same code that wasn't coalesced leaves the coalesced one waiting
+    KT_ASSERT(plain.Publish(uint32_t{ 1 }, ks_event_toggle_led) == ks_success);
+    KT_ASSERT(coalesced.Publish(uint32_t{ 2 }, ks_event_toggle_led) == ks_success);
+    KT_ASSERT(component.ProcessEventQueue(1, portMAX_DELAY) == ks_success);
+    KT_ASSERT(component.first == 1);
+
+    KT_ASSERT(coalesced.Publish(uint32_t{ 3 }, ks_event_toggle_led) == ks_success);
+    KT_ASSERT(coalesced.GetDeliveryStats(&component)->coalesced == 1);
+    KT_ASSERT(component.ProcessEventQueue() == ks_success);
+    KT_ASSERT(component.received == 2);
+    KT_ASSERT(component.missed == 1);
+    KT_ASSERT(component.last == 2);
+
+    KT_ASSERT(component.Destroy() == ks_success);
+    return true;
+}
@@ -0,0 +1,61 @@
+#include "KronosTest.h"
+#include "ks_payload.h"
+
+using namespace kronos;
+
+struct LargePayload {
+    uint8_t data[KS_PAYLOAD_INLINE_SIZE * 2];
+};
+
+KT_TEST(PayloadInlineTest) {
+    Payload payload;
+
+    KT_ASSERT(!payload.HasValue());
+    KT_ASSERT(payload.Emplace<uint32_t>(42) == ks_success);
+    KT_ASSERT(payload.Is<uint32_t>());
+    KT_ASSERT(!payload.Is<int32_t>());
+    KT_ASSERT(payload.Get<uint32_t>() == 42);
+    KT_ASSERT(Payload::GetBlockPoolStats().inUse == 0);
+
+    return true;
+}
+
+KT_TEST(PayloadBlockTest) {
+    static_assert(!Payload::FitsInline<LargePayload>());
+
+    {
+        Payload payload;
+        LargePayload value{};
+        value.data[0] = 7;
+
+        KT_ASSERT(payload.Emplace<LargePayload>(value) == ks_success);
+        KT_ASSERT(payload.Get<LargePayload>().data[0] == 7);
+        KT_ASSERT(Payload::GetBlockPoolStats().inUse == 1);
+    }
+
+    KT_ASSERT(Payload::GetBlockPoolStats().inUse == 0);
+
+    return true;
+}
+
+KT_TEST(PayloadAdoptTest) {
+    static Pool<LargePayload, 1> loans;
+
+    {
+        Payload payload;
+        LargePayload* value = loans.Acquire();
+        value->data[0] = 3;
+
+        payload.Adopt<LargePayload>(value, [](void* adopted, void* owner) {
+            loans.Release(static_cast<LargePayload*>(adopted));
+        });
+
+        KT_ASSERT(&payload.Get<LargePayload>() == value);
+        KT_ASSERT(loans.GetStats().inUse == 1);
+        KT_ASSERT(Payload::GetBlockPoolStats().inUse == 0);
+    }
+
+    KT_ASSERT(loans.GetStats().inUse == 0);
+
+    return true;
+}
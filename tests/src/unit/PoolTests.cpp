@@ -0,0 +1,52 @@
+#include "KronosTest.h"
+#include "ks_pool.h"
+
+using namespace kronos;
+
+KT_TEST(PoolAcquireAndReleaseTest) {
+    static Pool<int, 4> pool;
+
+    int* first = pool.Acquire(10);
+    int* second = pool.Acquire(11);
+
+    KT_ASSERT(first != nullptr && second != nullptr);
+    KT_ASSERT(*first == 10);
+    KT_ASSERT(*second == 11);
+    KT_ASSERT(pool.GetStats().inUse == 2);
+
+    KT_ASSERT(pool.Release(first) == ks_success);
+    KT_ASSERT(pool.Release(second) == ks_success);
+    KT_ASSERT(pool.GetStats().inUse == 0);
+    KT_ASSERT(pool.GetStats().highWaterMark == 2);
+
+    return true;
+}
+
+KT_TEST(PoolExhaustionTest) {
+    static Pool<int, 2> pool;
+
+    int* first = pool.Acquire(1);
+    int* second = pool.Acquire(2);
+
+    KT_ASSERT(pool.Acquire(3) == nullptr);
+    KT_ASSERT(pool.GetStats().exhausted == 1);
+
+    pool.Release(first);
+    int* third = pool.Acquire(3);
+    KT_ASSERT(third == first);
+
+    pool.Release(second);
+    pool.Release(third);
+
+    return true;
+}
+
+KT_TEST(PoolForeignReleaseTest) {
+    static Pool<int, 2> pool;
+    int value = 0;
+
+    KT_ASSERT(pool.Release(&value) == ks_error);
+    KT_ASSERT(pool.GetStats().released == 0);
+
+    return true;
+}
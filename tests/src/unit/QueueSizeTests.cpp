@@ -0,0 +1,48 @@
+#include "KronosTest.h"
+#include "ks_bus.h"
+
+using namespace kronos;
+
+KT_TEST(QueueSizeTest) {
+    Bus bus("B_TEST_QUEUE_SIZE");
+    ComponentQueued component("CQ_TEST_QUEUE_SIZE", 0, 4);
+
+    KT_ASSERT(component.GetQueueSize(ks_event_priority_normal) == 4);
+    KT_ASSERT(component.GetQueueSize(ks_event_priority_high) == KS_QUEUE_HIGH_PRIORITY_SIZE);
+    KT_ASSERT(component.SetQueueSize(ks_event_priority_low, 2) == ks_success);
+
+    KT_ASSERT(component.Init() == ks_success);
+    KT_ASSERT(component.SetQueueSize(ks_event_priority_low, 8) == ks_error_component_queue_created);
+    KT_ASSERT(component.GetQueueSize(ks_event_priority_low) == 2);
+    KT_ASSERT(bus.AddReceivingComponent(&component, ks_overflow_drop_newest) == ks_success);
+
+    for (uint32_t i = 0; i < 5; i++)
+        KT_ASSERT(bus.Publish(i, ks_event_toggle_led) == ks_success);
+
+    KT_ASSERT(bus.GetDeliveryStats(&component)->dropped == 1);
+
+    KT_ASSERT(component.Destroy() == ks_success);
+    return true;
+}
+
+KT_TEST(QueueHighWaterTest) {
+    Bus bus("B_TEST_HIGH_WATER");
+    ComponentQueued component("CQ_TEST_HIGH_WATER");
+    KT_ASSERT(component.Init() == ks_success);
+    KT_ASSERT(bus.AddReceivingComponent(&component) == ks_success);
+
+    for (uint32_t i = 0; i < 3; i++)
+        KT_ASSERT(bus.Publish(i, ks_event_toggle_led) == ks_success);
+
+    KT_ASSERT(component.GetHighWater(ks_event_priority_normal) == 3);
+    KT_ASSERT(component.GetHighWater(ks_event_priority_high) == 0);
+
+    KT_ASSERT(component.ProcessEventQueue() == ks_success);
+    KT_ASSERT(component.GetHighWater(ks_event_priority_normal) == 3);
+
+    component.ResetHighWater();
+    KT_ASSERT(component.GetHighWater(ks_event_priority_normal) == 0);
+
+    KT_ASSERT(component.Destroy() == ks_success);
+    return true;
+}
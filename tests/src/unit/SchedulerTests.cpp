@@ -0,0 +1,101 @@
+#include "KronosTest.h"
+#include "ks_timing_wheel.h"
+#include "ks_scheduler.h"
+
+using namespace kronos;
+
+KT_TEST(TimingWheelTest) {
+    static TimingWheel wheel;
+    static WheelEntry entries[10];
+    const KsTickType deadlines[] = { 1, 2, 63, 64, 65, 4095, 4096, 4097, 70000, 300000 };
+
+    for (size_t i = 0; i < std::size(entries); i++)
+        wheel.Insert(&entries[i], deadlines[i]);
+
+    KT_ASSERT(wheel.GetSize() == std::size(entries));
+
+    // Every entry is due exactly at its deadline, whatever the level it started on
+    size_t due = 0;
+    bool onTime = true;
+    while (wheel.GetSize() > 0 && wheel.GetNow() < deadlines[std::size(deadlines) - 1]) {
+        due += wheel.Advance([&](WheelEntry* entry) {
+            if (entry->deadline != wheel.GetNow()) onTime = false;
+        });
+    }
+
+    KT_ASSERT(onTime);
+    KT_ASSERT(due == std::size(entries));
+    KT_ASSERT(wheel.GetNow() == deadlines[std::size(deadlines) - 1]);
+
+    return true;
+}
+
+KT_TEST(TimingWheelRemoveTest) {
+    static TimingWheel wheel;
+    WheelEntry periodic, cancelled, moved;
+
+    wheel.Insert(&periodic, 10);
+    wheel.Insert(&cancelled, 20);
+    wheel.Insert(&moved, 30);
+
+    wheel.Remove(&cancelled);
+    wheel.Insert(&moved, 5);
+    KT_ASSERT(!TimingWheel::Contains(&cancelled));
+    KT_ASSERT(wheel.GetSize() == 2);
+
+    // The periodic entry is inserted again every time it is due
+    uint32_t periodicDue = 0, movedDue = 0;
+    for (size_t i = 0; i < 100; i++) {
+        wheel.Advance([&](WheelEntry* entry) {
+            if (entry == &periodic) {
+                periodicDue++;
+                wheel.Insert(entry, entry->deadline + 10);
+            } else if (entry == &moved) {
+                movedDue++;
+            }
+        });
+    }
+
+    KT_ASSERT(periodicDue == 10);
+    KT_ASSERT(movedDue == 1);
+    KT_ASSERT(wheel.GetSize() == 1);
+
+    wheel.Remove(&periodic);
+    KT_ASSERT(wheel.GetSize() == 0);
+
+    return true;
+}
+
+KT_TEST(SchedulePhaseTest) {
+    Scheduler::CreateInstance();
+    ComponentQueued component("CQ_TEST_SCHEDULE_PHASE");
+    KsScheduleId fixed, first, second;
+
+    // 1000 ms is 20 ticks, due on ticks 5, 25, 45 and so on
+    KT_ASSERT(Scheduler::ScheduleEvent(1000, ks_event_scheduler_tick, &component, 250, &fixed) == ks_success);
+    KT_ASSERT(Scheduler::GetTickLoad(5) == 1);
+    KT_ASSERT(Scheduler::GetTickLoad(25) == 1);
+    KT_ASSERT(Scheduler::GetTickLoad(0) == 0);
+
+    // Automatic phases go to the ticks that are least loaded
+    KT_ASSERT(Scheduler::ScheduleEvent(100, ks_event_save_param, &component, KS_SCHEDULE_PHASE_AUTO, &first) == ks_success);
+    KT_ASSERT(Scheduler::ScheduleEvent(100, ks_event_health_ping, &component, KS_SCHEDULE_PHASE_AUTO, &second) == ks_success);
+    KT_ASSERT(Scheduler::GetTickLoad(0) == 1);
+    KT_ASSERT(Scheduler::GetTickLoad(1) == 1);
+    KT_ASSERT(Scheduler::GetTickLoad(5) == 2);
+
+    ScheduleStats stats;
+    KT_ASSERT(Scheduler::GetScheduleStats(first, &stats) == ks_success);
+    KT_ASSERT(stats.deliveries == 0);
+
+    KT_ASSERT(Scheduler::Cancel(fixed) == ks_success);
+    KT_ASSERT(Scheduler::Cancel(first) == ks_success);
+    KT_ASSERT(Scheduler::Cancel(second) == ks_success);
+    KT_ASSERT(Scheduler::GetTickLoad(5) == 0);
+    KT_ASSERT(Scheduler::GetScheduleStats(first, &stats) == ks_error_scheduler_missing);
+
+    // The subscription of the component is given back with its last schedule
+    KT_ASSERT(Scheduler::GetDeliveryStats(&component) == nullptr);
+
+    return true;
+}
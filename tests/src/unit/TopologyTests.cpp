@@ -0,0 +1,62 @@
+#include "KronosTest.h"
+#include "ks_bus.h"
+
+using namespace kronos;
+
+//! Queued component counting the events it processes.
+class TopologyTestComponent : public ComponentQueued {
+public:
+    TopologyTestComponent() : ComponentQueued("CQ_TEST_TOPOLOGY") {}
+
+    KsResult ProcessEvent(const EventMessage& message) override {
+        received++;
+        return ks_success;
+    }
+
+    size_t received = 0;
+};
+
+static TopologyTestComponent s_Component;
+static Bus s_Bus("B_TEST_TOPOLOGY");
+
+static Subscription s_BusSubscriptions[] = {
+    { .component = &s_Component, .overflow = ks_overflow_drop_newest }
+};
+
+static constexpr TopologyComponent s_Components[] = {
+    { "CQ_TEST_TOPOLOGY", &s_Component }
+};
+
+static constexpr TopologyBus s_Busses[] = {
+    { "B_TEST_TOPOLOGY", &s_Bus, s_BusSubscriptions }
+};
+
+static constexpr Topology s_Topology{ s_Components, s_Busses };
+
+static constexpr TopologyComponent s_MistypedComponents[] = {
+    { "CQ_TEST_TOPOLOGY_MISTYPED", &s_Component }
+};
+
+static constexpr Topology s_MistypedTopology{ s_MistypedComponents, {} };
+
+KT_TEST(TopologyTest) {
+    KT_ASSERT(Framework::SetTopology(s_MistypedTopology) == ks_error_topology_name);
+    KT_ASSERT(Framework::SetTopology(s_Topology) == ks_success);
+    KT_ASSERT(Framework::SetTopology(s_Topology) == ks_error_topology_exists);
+    KT_ASSERT(Framework::CreateBus("B_TEST_TOPOLOGY") == nullptr);
+
+    BusHandle<> bus("B_TEST_TOPOLOGY");
+    ComponentHandle<TopologyTestComponent> component("CQ_TEST_TOPOLOGY");
+    KT_ASSERT(bus.Get() == &s_Bus);
+    KT_ASSERT(component.Get() == &s_Component);
+    KT_ASSERT(Framework::GetBus("B_TEST_TOPOLOGY") == &s_Bus);
+
+    KT_ASSERT(s_Component.Init() == ks_success);
+    KT_ASSERT(bus->Publish(ks_event_toggle_led) == ks_success);
+    KT_ASSERT(bus->GetDeliveryStats(&s_Component)->delivered == 1);
+    KT_ASSERT(s_Component.ProcessEventQueue() == ks_success);
+    KT_ASSERT(s_Component.received == 1);
+
+    KT_ASSERT(s_Component.Destroy() == ks_success);
+    return true;
+}
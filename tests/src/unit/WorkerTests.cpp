@@ -0,0 +1,67 @@
+#include "KronosTest.h"
+#include "ks_component_worker.h"
+#include "ks_bus.h"
+
+using namespace kronos;
+
+KT_TEST(WorkerRegisterTest) {
+    static ComponentWorker worker("CW_TEST_REGISTER", KS_COMPONENT_STACK_SIZE_SMALL, KS_COMPONENT_PRIORITY_LOW);
+    static ComponentQueued components[] = { ComponentQueued("CQ_TEST_WORKER_0"), ComponentQueued("CQ_TEST_WORKER_1") };
+
+    KT_ASSERT(worker.RegisterComponent(&components[0], KS_COMPONENT_PRIORITY_LOW) == ks_success);
+    KT_ASSERT(worker.RegisterComponent(&components[1], KS_COMPONENT_PRIORITY_HIGH) == ks_success);
+    KT_ASSERT(worker.GetComponentCount() == 2);
+
+    KT_ASSERT(worker.RemoveComponent(&components[0]) == ks_success);
+    KT_ASSERT(worker.RemoveComponent(&components[0]) == ks_error_component_worker_missing);
+    KT_ASSERT(worker.GetComponentCount() == 1);
+
+    return true;
+}
+
+KT_TEST(WorkerBalanceTest) {
+    static ComponentWorker first("CW_TEST_BALANCE_0", KS_COMPONENT_STACK_SIZE_SMALL, KS_COMPONENT_PRIORITY_LOW);
+    static ComponentWorker second("CW_TEST_BALANCE_1", KS_COMPONENT_STACK_SIZE_SMALL, KS_COMPONENT_PRIORITY_LOW);
+    static ComponentWorker* const pool[] = { &first, &second };
+    static ComponentQueued components[] = { ComponentQueued("CQ_TEST_BALANCE_0"), ComponentQueued("CQ_TEST_BALANCE_1") };
+
+    first.SetPool(pool);
+    second.SetPool(pool);
+
+    KT_ASSERT(first.RegisterComponent(&components[0]) == ks_success);
+    KT_ASSERT(first.RegisterComponent(&components[1]) == ks_success);
+
+    // Nothing waited yet, so no component is worth moving
+    KT_ASSERT(first.GetLoad() == 0);
+    KT_ASSERT(first.Balance() == ks_success);
+    KT_ASSERT(first.GetComponentCount() == 2);
+    KT_ASSERT(second.GetComponentCount() == 0);
+
+    return true;
+}
+
+KT_TEST(WorkerBudgetTest) {
+    Bus bus("B_TEST_BUDGET");
+    ComponentQueued component("CQ_TEST_BUDGET");
+    KT_ASSERT(component.Init() == ks_success);
+    KT_ASSERT(bus.AddReceivingComponent(&component) == ks_success);
+
+    for (uint32_t i = 0; i < 5; i++)
+        KT_ASSERT(bus.Publish(i, ks_event_toggle_led) == ks_success);
+
+    // A visit stops at the event budget and leaves the rest for the next one
+    component.SetBudget(3, portMAX_DELAY);
+    KT_ASSERT(component.TryProcessEventQueue());
+    KT_ASSERT(component.GetVisitStats().events == 3);
+    KT_ASSERT(component.GetVisitStats().budgetExhausted == 1);
+    KT_ASSERT(component.HasPendingEvents());
+
+    KT_ASSERT(component.TryProcessEventQueue());
+    KT_ASSERT(component.GetVisitStats().visits == 2);
+    KT_ASSERT(component.GetVisitStats().events == 5);
+    KT_ASSERT(component.GetVisitStats().maxEvents == 3);
+    KT_ASSERT(!component.HasPendingEvents());
+
+    KT_ASSERT(component.Destroy() == ks_success);
+    return true;
+}